@@ -0,0 +1,494 @@
+/** -*- C++ -*-
+ * @file Algebra.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef GEOM_ALGEBRA_HPP
+#define GEOM_ALGEBRA_HPP
+
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+
+namespace geom
+{
+
+/**
+ * @brief Closed forms for small square matrices.
+ *
+ * Specialized for N = 2, 3 and 4: determinants and inverses are expanded
+ * by cofactors, without loops nor pivoting. Other sizes do not compile.
+ * Usable in constant expressions, as transpose, determinant and inverse.
+ */
+template <int N, class Real>
+struct Square;
+
+/**
+ * @brief Transposed matrix.
+ */
+template <int M, int N, class Real>
+constexpr Matrix<N, M, Real> transpose( const Matrix<M, N, Real> & m );
+
+/**
+ * @brief Determinant of a 2x2, 3x3 or 4x4 matrix.
+ */
+template <int N, class Real>
+constexpr Real determinant( const Matrix<N, N, Real> & m );
+
+/**
+ * @brief Inverse of a 2x2, 3x3 or 4x4 matrix.
+ * @param m The matrix.
+ * @param inv Output inverse (unchanged if m is singular).
+ * @return false if the determinant of m is null.
+ */
+template <int N, class Real>
+constexpr bool inverse( const Matrix<N, N, Real> & m, Matrix<N, N, Real> & inv );
+
+/**
+ * @brief Inverse of a 2x2, 3x3 or 4x4 matrix.
+ * @throw std::runtime_error If the determinant of m is null.
+ */
+template <int N, class Real>
+Matrix<N, N, Real> inverse( const Matrix<N, N, Real> & m );
+
+/**
+ * @brief QR decomposition (modified Gram-Schmidt on the columns).
+ * @param m The matrix (M >= N).
+ * @param q Output matrix with orthonormal columns.
+ * @param r Output upper triangular matrix, so that m = q * r.
+ * @return false if the columns of m are linearly dependent.
+ */
+template <int M, int N, class Real>
+bool qr( const Matrix<M, N, Real> & m, Matrix<M, N, Real> & q, Matrix<N, N, Real> & r );
+
+/**
+ * @brief Orthonormalizes the columns of a matrix, in order.
+ *
+ * The first column keeps its direction; typically used to remove the
+ * drift of a rotation (e.g. a T, N, B frame) after many products.
+ * @return false if the columns are linearly dependent (m is unchanged).
+ */
+template <int M, int N, class Real>
+bool orthonormalize( Matrix<M, N, Real> & m );
+
+/**
+ * @brief Eigen decomposition of a 3x3 symmetric matrix (cyclic Jacobi).
+ *
+ * Each sweep applies the three plane rotations, unrolled; a few sweeps
+ * reach the precision of Real.
+ * @param a The symmetric matrix (only used through its upper triangle).
+ * @param values Output eigenvalues, in decreasing order.
+ * @param vectors Output orthonormal eigenvectors, in columns, so that
+ * a = vectors * diag( values ) * transpose( vectors ).
+ */
+template <class Real>
+void symmetricEigen( const Matrix<3, 3, Real> & a, Vector<3, Real> & values, Matrix<3, 3, Real> & vectors );
+
+/**
+ * @brief Polar decomposition of a 2x2, 3x3 or 4x4 matrix.
+ *
+ * Scaled Newton iteration R = ( g R + R^-T / g ) / 2, which converges
+ * quadratically (about 6 iterations).
+ * @param a The matrix.
+ * @param r Output orthogonal factor (a reflection if det( a ) < 0).
+ * @param s Output symmetric factor, so that a = r * s.
+ * @return false if a is singular.
+ */
+template <int N, class Real>
+bool polar( const Matrix<N, N, Real> & a, Matrix<N, N, Real> & r, Matrix<N, N, Real> & s );
+
+// -----------------------------------------------------------------------------
+
+template <class Real>
+struct Square<2, Real>
+{
+	static constexpr Real determinant( const Matrix<2, 2, Real> & m )
+	{
+		return m[ 0 ][ 0 ] * m[ 1 ][ 1 ] - m[ 0 ][ 1 ] * m[ 1 ][ 0 ];
+	}
+
+	static constexpr bool inverse( const Matrix<2, 2, Real> & m, Matrix<2, 2, Real> & inv )
+	{
+		Real det = 0, d = 0;
+
+		det = determinant( m );
+		if ( det == 0 )
+			return false;
+		d = 1 / det;
+
+		Real b[ 4 ] = {
+			 m[ 1 ][ 1 ] * d, -m[ 0 ][ 1 ] * d,
+			-m[ 1 ][ 0 ] * d,  m[ 0 ][ 0 ] * d
+		};
+		inv = Matrix<2, 2, Real>( b );
+		return true;
+	}
+};
+
+template <class Real>
+struct Square<3, Real>
+{
+	static constexpr Real determinant( const Matrix<3, 3, Real> & m )
+	{
+		return m[ 0 ][ 0 ] * ( m[ 1 ][ 1 ] * m[ 2 ][ 2 ] - m[ 1 ][ 2 ] * m[ 2 ][ 1 ] )
+		     - m[ 0 ][ 1 ] * ( m[ 1 ][ 0 ] * m[ 2 ][ 2 ] - m[ 1 ][ 2 ] * m[ 2 ][ 0 ] )
+		     + m[ 0 ][ 2 ] * ( m[ 1 ][ 0 ] * m[ 2 ][ 1 ] - m[ 1 ][ 1 ] * m[ 2 ][ 0 ] );
+	}
+
+	static constexpr bool inverse( const Matrix<3, 3, Real> & m, Matrix<3, 3, Real> & inv )
+	{
+		Real c00 = 0, c01 = 0, c02 = 0, det = 0, d = 0;
+
+		c00 = m[ 1 ][ 1 ] * m[ 2 ][ 2 ] - m[ 1 ][ 2 ] * m[ 2 ][ 1 ];
+		c01 = m[ 1 ][ 2 ] * m[ 2 ][ 0 ] - m[ 1 ][ 0 ] * m[ 2 ][ 2 ];
+		c02 = m[ 1 ][ 0 ] * m[ 2 ][ 1 ] - m[ 1 ][ 1 ] * m[ 2 ][ 0 ];
+
+		det = m[ 0 ][ 0 ] * c00 + m[ 0 ][ 1 ] * c01 + m[ 0 ][ 2 ] * c02;
+		if ( det == 0 )
+			return false;
+		d = 1 / det;
+
+		Real b[ 9 ] = {
+			c00 * d,
+			( m[ 0 ][ 2 ] * m[ 2 ][ 1 ] - m[ 0 ][ 1 ] * m[ 2 ][ 2 ] ) * d,
+			( m[ 0 ][ 1 ] * m[ 1 ][ 2 ] - m[ 0 ][ 2 ] * m[ 1 ][ 1 ] ) * d,
+			c01 * d,
+			( m[ 0 ][ 0 ] * m[ 2 ][ 2 ] - m[ 0 ][ 2 ] * m[ 2 ][ 0 ] ) * d,
+			( m[ 0 ][ 2 ] * m[ 1 ][ 0 ] - m[ 0 ][ 0 ] * m[ 1 ][ 2 ] ) * d,
+			c02 * d,
+			( m[ 0 ][ 1 ] * m[ 2 ][ 0 ] - m[ 0 ][ 0 ] * m[ 2 ][ 1 ] ) * d,
+			( m[ 0 ][ 0 ] * m[ 1 ][ 1 ] - m[ 0 ][ 1 ] * m[ 1 ][ 0 ] ) * d
+		};
+		inv = Matrix<3, 3, Real>( b );
+		return true;
+	}
+};
+
+/*
+	The 4x4 cofactors are built from the six 2x2 minors of the two upper
+	rows (s) and the six 2x2 minors of the two lower rows (c) (Laplace
+	expansion).
+*/
+template <class Real>
+struct Square<4, Real>
+{
+	static constexpr Real determinant( const Matrix<4, 4, Real> & m )
+	{
+		Real s[ 6 ] = {}, c[ 6 ] = {};
+		minors( m, s, c );
+		return s[ 0 ] * c[ 5 ] - s[ 1 ] * c[ 4 ] + s[ 2 ] * c[ 3 ] + s[ 3 ] * c[ 2 ] - s[ 4 ] * c[ 1 ] + s[ 5 ] * c[ 0 ];
+	}
+
+	static constexpr bool inverse( const Matrix<4, 4, Real> & m, Matrix<4, 4, Real> & inv )
+	{
+		Real s[ 6 ] = {}, c[ 6 ] = {}, det = 0, d = 0;
+
+		minors( m, s, c );
+		det = s[ 0 ] * c[ 5 ] - s[ 1 ] * c[ 4 ] + s[ 2 ] * c[ 3 ] + s[ 3 ] * c[ 2 ] - s[ 4 ] * c[ 1 ] + s[ 5 ] * c[ 0 ];
+		if ( det == 0 )
+			return false;
+		d = 1 / det;
+
+		Real b[ 16 ] = {
+			(  m[ 1 ][ 1 ] * c[ 5 ] - m[ 1 ][ 2 ] * c[ 4 ] + m[ 1 ][ 3 ] * c[ 3 ] ) * d,
+			( -m[ 0 ][ 1 ] * c[ 5 ] + m[ 0 ][ 2 ] * c[ 4 ] - m[ 0 ][ 3 ] * c[ 3 ] ) * d,
+			(  m[ 3 ][ 1 ] * s[ 5 ] - m[ 3 ][ 2 ] * s[ 4 ] + m[ 3 ][ 3 ] * s[ 3 ] ) * d,
+			( -m[ 2 ][ 1 ] * s[ 5 ] + m[ 2 ][ 2 ] * s[ 4 ] - m[ 2 ][ 3 ] * s[ 3 ] ) * d,
+
+			( -m[ 1 ][ 0 ] * c[ 5 ] + m[ 1 ][ 2 ] * c[ 2 ] - m[ 1 ][ 3 ] * c[ 1 ] ) * d,
+			(  m[ 0 ][ 0 ] * c[ 5 ] - m[ 0 ][ 2 ] * c[ 2 ] + m[ 0 ][ 3 ] * c[ 1 ] ) * d,
+			( -m[ 3 ][ 0 ] * s[ 5 ] + m[ 3 ][ 2 ] * s[ 2 ] - m[ 3 ][ 3 ] * s[ 1 ] ) * d,
+			(  m[ 2 ][ 0 ] * s[ 5 ] - m[ 2 ][ 2 ] * s[ 2 ] + m[ 2 ][ 3 ] * s[ 1 ] ) * d,
+
+			(  m[ 1 ][ 0 ] * c[ 4 ] - m[ 1 ][ 1 ] * c[ 2 ] + m[ 1 ][ 3 ] * c[ 0 ] ) * d,
+			( -m[ 0 ][ 0 ] * c[ 4 ] + m[ 0 ][ 1 ] * c[ 2 ] - m[ 0 ][ 3 ] * c[ 0 ] ) * d,
+			(  m[ 3 ][ 0 ] * s[ 4 ] - m[ 3 ][ 1 ] * s[ 2 ] + m[ 3 ][ 3 ] * s[ 0 ] ) * d,
+			( -m[ 2 ][ 0 ] * s[ 4 ] + m[ 2 ][ 1 ] * s[ 2 ] - m[ 2 ][ 3 ] * s[ 0 ] ) * d,
+
+			( -m[ 1 ][ 0 ] * c[ 3 ] + m[ 1 ][ 1 ] * c[ 1 ] - m[ 1 ][ 2 ] * c[ 0 ] ) * d,
+			(  m[ 0 ][ 0 ] * c[ 3 ] - m[ 0 ][ 1 ] * c[ 1 ] + m[ 0 ][ 2 ] * c[ 0 ] ) * d,
+			( -m[ 3 ][ 0 ] * s[ 3 ] + m[ 3 ][ 1 ] * s[ 1 ] - m[ 3 ][ 2 ] * s[ 0 ] ) * d,
+			(  m[ 2 ][ 0 ] * s[ 3 ] - m[ 2 ][ 1 ] * s[ 1 ] + m[ 2 ][ 2 ] * s[ 0 ] ) * d
+		};
+		inv = Matrix<4, 4, Real>( b );
+		return true;
+	}
+
+	static constexpr void minors( const Matrix<4, 4, Real> & m, Real * s, Real * c )
+	{
+		s[ 0 ] = m[ 0 ][ 0 ] * m[ 1 ][ 1 ] - m[ 1 ][ 0 ] * m[ 0 ][ 1 ];
+		s[ 1 ] = m[ 0 ][ 0 ] * m[ 1 ][ 2 ] - m[ 1 ][ 0 ] * m[ 0 ][ 2 ];
+		s[ 2 ] = m[ 0 ][ 0 ] * m[ 1 ][ 3 ] - m[ 1 ][ 0 ] * m[ 0 ][ 3 ];
+		s[ 3 ] = m[ 0 ][ 1 ] * m[ 1 ][ 2 ] - m[ 1 ][ 1 ] * m[ 0 ][ 2 ];
+		s[ 4 ] = m[ 0 ][ 1 ] * m[ 1 ][ 3 ] - m[ 1 ][ 1 ] * m[ 0 ][ 3 ];
+		s[ 5 ] = m[ 0 ][ 2 ] * m[ 1 ][ 3 ] - m[ 1 ][ 2 ] * m[ 0 ][ 3 ];
+
+		c[ 0 ] = m[ 2 ][ 0 ] * m[ 3 ][ 1 ] - m[ 3 ][ 0 ] * m[ 2 ][ 1 ];
+		c[ 1 ] = m[ 2 ][ 0 ] * m[ 3 ][ 2 ] - m[ 3 ][ 0 ] * m[ 2 ][ 2 ];
+		c[ 2 ] = m[ 2 ][ 0 ] * m[ 3 ][ 3 ] - m[ 3 ][ 0 ] * m[ 2 ][ 3 ];
+		c[ 3 ] = m[ 2 ][ 1 ] * m[ 3 ][ 2 ] - m[ 3 ][ 1 ] * m[ 2 ][ 2 ];
+		c[ 4 ] = m[ 2 ][ 1 ] * m[ 3 ][ 3 ] - m[ 3 ][ 1 ] * m[ 2 ][ 3 ];
+		c[ 5 ] = m[ 2 ][ 2 ] * m[ 3 ][ 3 ] - m[ 3 ][ 2 ] * m[ 2 ][ 3 ];
+	}
+};
+
+template <int M, int N, class Real>
+constexpr Matrix<N, M, Real> transpose( const Matrix<M, N, Real> & m )
+{
+	Matrix<N, M, Real> t;
+	for ( int i = 0; i < M; i++ )
+	{
+		for ( int j = 0; j < N; j++ )
+			t[ j ][ i ] = m[ i ][ j ];
+	}
+	return t;
+}
+
+template <int N, class Real>
+constexpr Real determinant( const Matrix<N, N, Real> & m )
+{
+	return Square<N, Real>::determinant( m );
+}
+
+template <int N, class Real>
+constexpr bool inverse( const Matrix<N, N, Real> & m, Matrix<N, N, Real> & inv )
+{
+	return Square<N, Real>::inverse( m, inv );
+}
+
+template <int N, class Real>
+Matrix<N, N, Real> inverse( const Matrix<N, N, Real> & m )
+{
+	Matrix<N, N, Real> inv;
+	if ( !Square<N, Real>::inverse( m, inv ) )
+		throw std::runtime_error( "geom::inverse: singular matrix" );
+	return inv;
+}
+
+template <int M, int N, class Real>
+bool qr( const Matrix<M, N, Real> & m, Matrix<M, N, Real> & q, Matrix<N, N, Real> & r )
+{
+	Real a[ N ][ M ], norm, d;
+	int i, j, k;
+
+	static_assert( M >= N, "geom::qr: more columns than rows" );
+
+	for ( i = 0; i < M; i++ )
+	{
+		for ( j = 0; j < N; j++ )
+			a[ j ][ i ] = m[ i ][ j ];
+	}
+
+	r = Matrix<N, N, Real>();
+	for ( j = 0; j < N; j++ )
+	{
+		for ( k = 0; k < j; k++ )
+		{
+			d = 0;
+			for ( i = 0; i < M; i++ )
+				d += a[ k ][ i ] * a[ j ][ i ];
+			for ( i = 0; i < M; i++ )
+				a[ j ][ i ] -= d * a[ k ][ i ];
+			r[ k ][ j ] = d;
+		}
+
+		norm = 0;
+		for ( i = 0; i < M; i++ )
+			norm += a[ j ][ i ] * a[ j ][ i ];
+		norm = std::sqrt( norm );
+		if ( norm == 0 )
+			return false;
+
+		r[ j ][ j ] = norm;
+		for ( i = 0; i < M; i++ )
+			a[ j ][ i ] /= norm;
+	}
+
+	for ( i = 0; i < M; i++ )
+	{
+		for ( j = 0; j < N; j++ )
+			q[ i ][ j ] = a[ j ][ i ];
+	}
+	return true;
+}
+
+template <int M, int N, class Real>
+bool orthonormalize( Matrix<M, N, Real> & m )
+{
+	Matrix<M, N, Real> q;
+	Matrix<N, N, Real> r;
+
+	if ( !qr( m, q, r ) )
+		return false;
+	m = q;
+	return true;
+}
+
+template <class Real>
+void symmetricEigen( const Matrix<3, 3, Real> & a, Vector<3, Real> & values, Matrix<3, 3, Real> & vectors )
+{
+	static const int pairs[ 3 ][ 2 ] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+	const Real eps = std::numeric_limits<Real>::epsilon();
+	Real A[ 3 ][ 3 ], V[ 3 ][ 3 ];
+	Real off, scale, theta, t, c, s, apk, aqk;
+	int sweep, n, p, q, k, i, j;
+
+	for ( i = 0; i < 3; i++ )
+	{
+		for ( j = 0; j < 3; j++ )
+		{
+			A[ i ][ j ] = ( i <= j ? a[ i ][ j ] : a[ j ][ i ] );
+			V[ i ][ j ] = ( i == j ? 1 : 0 );
+		}
+	}
+
+	for ( sweep = 0; sweep < 32; sweep++ )
+	{
+		off = A[ 0 ][ 1 ] * A[ 0 ][ 1 ] + A[ 0 ][ 2 ] * A[ 0 ][ 2 ] + A[ 1 ][ 2 ] * A[ 1 ][ 2 ];
+		scale = A[ 0 ][ 0 ] * A[ 0 ][ 0 ] + A[ 1 ][ 1 ] * A[ 1 ][ 1 ] + A[ 2 ][ 2 ] * A[ 2 ][ 2 ];
+		if ( off <= eps * eps * scale || off == 0 )
+			break;
+
+		for ( n = 0; n < 3; n++ )
+		{
+			p = pairs[ n ][ 0 ];
+			q = pairs[ n ][ 1 ];
+			if ( A[ p ][ q ] == 0 )
+				continue;
+
+			// Rotation that cancels A[p][q] (Numerical Recipes, 11.1)
+			theta = ( A[ q ][ q ] - A[ p ][ p ] ) / ( 2 * A[ p ][ q ] );
+			t = 1 / ( std::fabs( theta ) + std::sqrt( theta * theta + 1 ) );
+			if ( theta < 0 )
+				t = -t;
+			c = 1 / std::sqrt( t * t + 1 );
+			s = t * c;
+
+			A[ p ][ p ] -= t * A[ p ][ q ];
+			A[ q ][ q ] += t * A[ p ][ q ];
+			A[ p ][ q ] = A[ q ][ p ] = 0;
+
+			k = 3 - p - q;
+			apk = A[ p ][ k ];
+			aqk = A[ q ][ k ];
+			A[ p ][ k ] = A[ k ][ p ] = c * apk - s * aqk;
+			A[ q ][ k ] = A[ k ][ q ] = s * apk + c * aqk;
+
+			for ( i = 0; i < 3; i++ )
+			{
+				apk = V[ i ][ p ];
+				aqk = V[ i ][ q ];
+				V[ i ][ p ] = c * apk - s * aqk;
+				V[ i ][ q ] = s * apk + c * aqk;
+			}
+		}
+	}
+
+	// Sorts by decreasing eigenvalue
+	int order[ 3 ] = { 0, 1, 2 };
+	if ( A[ order[ 0 ] ][ order[ 0 ] ] < A[ order[ 1 ] ][ order[ 1 ] ] ) std::swap( order[ 0 ], order[ 1 ] );
+	if ( A[ order[ 1 ] ][ order[ 1 ] ] < A[ order[ 2 ] ][ order[ 2 ] ] ) std::swap( order[ 1 ], order[ 2 ] );
+	if ( A[ order[ 0 ] ][ order[ 0 ] ] < A[ order[ 1 ] ][ order[ 1 ] ] ) std::swap( order[ 0 ], order[ 1 ] );
+
+	for ( j = 0; j < 3; j++ )
+	{
+		values[ j ] = A[ order[ j ] ][ order[ j ] ];
+		for ( i = 0; i < 3; i++ )
+			vectors[ i ][ j ] = V[ i ][ order[ j ] ];
+	}
+}
+
+template <int N, class Real>
+bool polar( const Matrix<N, N, Real> & a, Matrix<N, N, Real> & r, Matrix<N, N, Real> & s )
+{
+	const Real eps = std::numeric_limits<Real>::epsilon();
+	Matrix<N, N, Real> R( a ), inv;
+	Real nR, nI, g, delta, x;
+	int it, i, j;
+
+	for ( it = 0; it < 32; it++ )
+	{
+		if ( !Square<N, Real>::inverse( R, inv ) )
+			return false;
+
+		nR = nI = 0;
+		for ( i = 0; i < N; i++ )
+		{
+			for ( j = 0; j < N; j++ )
+			{
+				nR += R[ i ][ j ] * R[ i ][ j ];
+				nI += inv[ i ][ j ] * inv[ i ][ j ];
+			}
+		}
+		g = std::sqrt( std::sqrt( nI / nR ) );
+
+		// R <- ( g R + R^-T / g ) / 2
+		delta = 0;
+		for ( i = 0; i < N; i++ )
+		{
+			for ( j = 0; j < N; j++ )
+			{
+				x = ( g * R[ i ][ j ] + inv[ j ][ i ] / g ) / 2;
+				delta += ( x - R[ i ][ j ] ) * ( x - R[ i ][ j ] );
+				R[ i ][ j ] = x;
+			}
+		}
+		if ( delta <= 16 * eps * eps * N )
+			break;
+	}
+
+	// S = R^T A, symmetrized
+	s = transpose( R ) * a;
+	for ( i = 0; i < N; i++ )
+	{
+		for ( j = i + 1; j < N; j++ )
+			s[ i ][ j ] = s[ j ][ i ] = ( s[ i ][ j ] + s[ j ][ i ] ) / 2;
+	}
+	r = R;
+	return true;
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace geom
+{
+
+extern template struct Square<2, float>;
+extern template struct Square<3, float>;
+extern template struct Square<4, float>;
+extern template struct Square<2, double>;
+extern template struct Square<3, double>;
+extern template struct Square<4, double>;
+
+} // namespace
+#endif
+
+#endif
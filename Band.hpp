@@ -0,0 +1,187 @@
+/** -*- C++ -*-
+ * @file Band.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef GEOM_BAND_HPP
+#define GEOM_BAND_HPP
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+
+namespace geom
+{
+
+/**
+ * @brief Band matrix class template.
+ *
+ * A n x n matrix whose non-zero entries satisfy -lower <= j-i <= upper,
+ * stored row by row in n x (lower+upper+1) values. LU factorization
+ * without pivoting keeps the band, so factorizing and solving take O(n)
+ * memory and time for a fixed bandwidth.
+ */
+template <class Real = float>
+class BandMatrix
+{
+public:
+	/**
+	 * @brief Null matrix constructor.
+	 * @param n Number of rows and columns.
+	 * @param lower Number of sub-diagonals.
+	 * @param upper Number of super-diagonals.
+	 */
+	BandMatrix( int n = 0, int lower = 0, int upper = 0 )
+	{
+		resize( n, lower, upper );
+	}
+
+	/**
+	 * @brief Resizes to a null matrix.
+	 */
+	void resize( int n, int lower, int upper )
+	{
+		_n = n;
+		_lower = lower;
+		_upper = upper;
+		_data.assign( (std::size_t)n * ( lower + upper + 1 ), 0. );
+	}
+
+	inline int size() const  { return _n; }
+	inline int lower() const { return _lower; }
+	inline int upper() const { return _upper; }
+
+	/**
+	 * @brief Checks if ( i, j ) is inside the band.
+	 */
+	inline bool inBand( int i, int j ) const
+	{
+		return j - i >= -_lower && j - i <= _upper;
+	}
+
+	/**
+	 * @brief Const element accessor (inside the band).
+	 */
+	inline const Real & operator()( int i, int j ) const
+	{
+		assert( inBand( i, j ) );
+		return _data[ (std::size_t)i * ( _lower + _upper + 1 ) + ( j - i + _lower ) ];
+	}
+
+	/**
+	 * @brief Element accessor (inside the band).
+	 */
+	inline Real & operator()( int i, int j )
+	{
+		assert( inBand( i, j ) );
+		return _data[ (std::size_t)i * ( _lower + _upper + 1 ) + ( j - i + _lower ) ];
+	}
+
+	/**
+	 * @brief LU factorization in place, without pivoting.
+	 *
+	 * Suited to diagonally dominant, totally positive (B-spline collocation)
+	 * and symmetric positive definite (normal equations) matrices.
+	 * @return False if a pivot is zero (the matrix is left partially factorized).
+	 */
+	bool factorize();
+
+	/**
+	 * @brief Solves A x = b with the factorized matrix.
+	 * @param x In: the right-hand side b, out: the solution (n values of
+	 * a type with x -= y * r and x /= r, e.g. geom::Vector).
+	 */
+	template <class T>
+	void solve( T * x ) const;
+
+private:
+	std::vector<Real> _data;
+	int _n;
+	int _lower;
+	int _upper;
+};
+
+// -----------------------------------------------------------------------------
+
+template <class Real>
+bool BandMatrix<Real>::factorize()
+{
+	Real pivot, l;
+	int i, j, k;
+
+	for ( k = 0; k < _n; k++ )
+	{
+		pivot = (*this)( k, k );
+		if ( pivot == 0 )
+			return false;
+
+		// Multipliers below the pivot, update of the band on their right
+		for ( i = k+1; i <= std::min( _n-1, k+_lower ); i++ )
+		{
+			l = ( (*this)( i, k ) /= pivot );
+			if ( l == 0 )
+				continue;
+			for ( j = k+1; j <= std::min( _n-1, k+_upper ); j++ )
+				(*this)( i, j ) -= l * (*this)( k, j );
+		}
+	}
+	return true;
+}
+
+template <class Real>
+template <class T>
+void BandMatrix<Real>::solve( T * x ) const
+{
+	int i, j;
+
+	// L y = b (unit diagonal)
+	for ( i = 0; i < _n; i++ )
+		for ( j = std::max( 0, i-_lower ); j < i; j++ )
+			x[ i ] -= x[ j ] * (*this)( i, j );
+
+	// U x = y
+	for ( i = _n-1; i >= 0; i-- )
+	{
+		for ( j = i+1; j <= std::min( _n-1, i+_upper ); j++ )
+			x[ i ] -= x[ j ] * (*this)( i, j );
+		x[ i ] /= (*this)( i, i );
+	}
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace geom
+{
+
+extern template class BandMatrix<float>;
+extern template class BandMatrix<double>;
+
+} // namespace
+#endif
+
+#endif
@@ -0,0 +1,445 @@
+/** -*- C++ -*-
+ * @file Basis.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef BASIS_HPP
+#define BASIS_HPP
+
+#include "Instrument.hpp"
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+/**
+ * B-spline basis kernels, shared by the curve classes and the curve views.
+ * Knots are read through U[ i ], so U may be a pointer or any array-like
+ * accessor (e.g. curve::Strided).
+ */
+namespace basis
+{
+
+/**
+ * @brief Finds the knot span of u (binary search).
+ * @param n Index of the last control point.
+ * @param p The degree.
+ * @param U Knots, n+p+2 values.
+ * @see Algorithm A2.1, page 68, The NURBS Book (Springer 1997).
+ */
+template <class Real, class Knots>
+int findSpan( int n, int p, const Real & u, const Knots & U );
+
+/**
+ * @brief Finds the knot span of u in equally spaced knots (no search).
+ * @see findSpan
+ */
+template <class Real, class Knots>
+int uniformSpan( int n, int p, const Real & u, const Knots & U );
+
+/**
+ * @param N Array of size p+1
+ * @see Algorithm A2.2, page 70, The NURBS Book (Springer 1997).
+ */
+template <class Real, class Knots>
+void basisFuns( int i, const Real & u, int p, const Knots & U, Real * N );
+
+/**
+ * @param ders Array of size (n+1) x (p+1), row k holds the k-th derivatives.
+ * @see Algorithm A2.3, page 72, The NURBS Book (Springer 1997).
+ */
+template <class Real, class Knots>
+void dersBasisFuns( int i, const Real & u, int p, int n, const Knots & U, Real * ders );
+
+/**
+ * @brief basisFuns() at Lanes parameters at once.
+ *
+ * Same recursion, with the knots gathered per lane, so that every step
+ * runs along the lanes (SIMD).
+ * @param i Spans of the parameters, array of size Lanes.
+ * @param u The parameters, array of size Lanes.
+ * @param N Array of size (p+1) x Lanes, N[ j*Lanes + l ] for lane l.
+ */
+template <int Lanes, class Real, class Knots>
+void basisFunsLanes( const int * i, const Real * u, int p, const Knots & U, Real * N );
+
+/**
+ * @brief dersBasisFuns() at Lanes parameters at once.
+ * @param i Spans of the parameters, array of size Lanes.
+ * @param u The parameters, array of size Lanes.
+ * @param ders Array of size (n+1) x (p+1) x Lanes, ders[ ( k*(p+1) + j )*Lanes + l ].
+ */
+template <int Lanes, class Real, class Knots>
+void dersBasisFunsLanes( const int * i, const Real * u, int p, int n, const Knots & U, Real * ders );
+
+/**
+ * @brief Derivatives of a rational curve from those of its homogeneous form.
+ * @param ders In: derivatives of the weighted points (Aders), size d+1.
+ * Out: derivatives of the curve (CK), ders[0] being the point.
+ * @param wders Derivatives of the weight, size d+1.
+ * @see Algorithm A4.2, page 127, The NURBS Book (Springer 1997).
+ */
+template <class Point, class Real>
+void rationalDerivs( Point * ders, Real * wders, int d );
+
+/**
+ * @brief Keeps u in [low, high] (clamped) or wraps it around (periodic).
+ */
+template <class Real>
+void adjustParameter( Real & u, const Real & low, const Real & high, bool clamped );
+
+// -----------------------------------------------------------------------------
+
+template <class Real, class Knots>
+int findSpan( int n, int p, const Real & u, const Knots & U )
+{
+	int low, high, mid;
+
+	GEOM_COUNT( FindSpan );
+
+	// Special case
+	if ( u <= U[ p ] ) return p;
+	if ( u >= U[ n+1 ] ) return n;
+
+	// Do binary search
+	low = p;
+	high = n + 1;
+	mid = ( low + high ) / 2;
+	while ( u < U[ mid ] || u >= U[ mid+1 ] )
+	{
+		if ( u < U[ mid ] )
+			high = mid;
+		else
+			low = mid;
+		mid = ( low + high ) / 2;
+	}
+	return mid;
+}
+
+template <class Real, class Knots>
+int uniformSpan( int n, int p, const Real & u, const Knots & U )
+{
+	int span;
+
+	GEOM_COUNT( FindSpan );
+
+	// Special case
+	if ( u <= U[ p ] ) return p;
+	if ( u >= U[ n+1 ] ) return n;
+
+	// Direct guess, then at most a step for rounding errors
+	span = p + (int)( ( u - U[ p ] ) / ( U[ n+1 ] - U[ p ] ) * ( n + 1 - p ) );
+	span = std::max( p, std::min( span, n ) );
+	while ( u < U[ span ] ) span--;
+	while ( u >= U[ span+1 ] ) span++;
+	return span;
+}
+
+template <class Real, class Knots>
+void basisFuns( int i, const Real & u, int p, const Knots & U, Real * N )
+{
+	Real left[ p+1 ], right[ p+1 ];
+	Real saved, temp;
+	int j, r;
+
+	GEOM_COUNT( BasisFuns );
+
+	N[ 0 ] = 1.;
+	for ( j = 1; j <= p; j++ )
+	{
+		left [ j ] = u - U[ i+1-j ];
+		right[ j ] = U[ i+j ] - u;
+		saved = 0.;
+		for ( r = 0; r < j; r++ )
+		{
+			temp = N[ r ] / ( right[ r+1 ] + left[ j-r ] );
+			N[ r ] = saved + right[ r+1 ] * temp;
+			saved = left[ j-r ] * temp;
+		}
+		N[ j ] = saved;
+	}
+}
+
+template <class Real, class Knots>
+void dersBasisFuns( int i, const Real & u, int p, int n, const Knots & U, Real * ders )
+{
+	Real ndu[ p+1 ][ p+1 ], a[ 2 ][ p+1 ];
+	Real left[ p+1 ], right[ p+1 ];
+	Real saved, temp, d;
+	int j, k, r, rk, pk, j1, j2, s1, s2;
+
+	GEOM_COUNT( DersBasisFuns );
+
+	ndu[ 0 ][ 0 ] = 1.;
+	for ( j = 1; j <= p; j++ )
+	{
+		left[ j ] = u - U[ i+1-j ];
+		right[ j ] = U[ i+j ] - u;
+		saved = 0.;
+		for ( r = 0; r < j; r++ )
+		{
+			// Lower triangle
+			ndu[ j ][ r ] = right[ r+1 ] + left[ j-r ];
+			temp = ndu[ r ][ j-1 ] / ndu[ j ][ r ];
+
+			// Upper triangle
+			ndu[ r ][ j ] = saved + right[ r+1 ] * temp;
+			saved = left[ j-r ] * temp;
+		}
+		ndu[ j ][ j ] = saved;
+	}
+
+	// Load the basis functions
+	for ( j = 0; j <= p; j++ )
+		ders[ j ] = ndu[ j ][ p ];
+
+	// This section computes the derivatives
+	for ( r = 0; r <= p; r++ )
+	{
+		// Alternate rows in array a
+		s1 = 0;
+		s2 = 1;
+		a[ 0 ][ 0 ] = 1.;
+		for ( k = 1; k <= n; k++ )
+		{
+			d = 0.;
+			rk = r - k;
+			pk = p - k;
+			if ( r >= k )
+			{
+				a[ s2 ][ 0 ] = a[ s1 ][ 0 ] / ndu[ pk+1 ][ rk ];
+				d = a[ s2 ][ 0 ] * ndu[ rk ][ pk ];
+			}
+			if ( rk >= -1 )
+				j1 = 1;
+			else
+				j1 = -rk;
+			if ( r-1 <= pk )
+				j2 = k - 1;
+			else
+				j2 = p - r;
+			for ( j = j1; j <= j2; j++ )
+			{
+				a[ s2 ][ j ] = ( a[ s1 ][ j ] - a[ s1 ][ j-1 ] ) / ndu[ pk+1 ][ rk+j ];
+				d += a[ s2 ][ j ] * ndu[ rk+j ][ pk ];
+			}
+			if ( r <= pk )
+			{
+				a[ s2 ][ k ] = -a[ s1 ][ k-1 ] / ndu[ pk+1 ][ r ];
+				d += a[ s2 ][ k ] * ndu[ r ][ pk ];
+			}
+			ders[ k*(p+1) + r ] = d;
+			// Switch rows
+			j = s1;
+			s1 = s2;
+			s2 = j;
+		}
+	}
+
+	// Multiply through by the correct factors
+	r = p;
+	for ( k = 1; k <= n; k++ )
+	{
+		for ( j = 0; j <= p; j++ )
+			ders[ k*(p+1) + j ] *= r;
+		r *= ( p - k );
+	}
+}
+
+template <int Lanes, class Real, class Knots>
+void basisFunsLanes( const int * i, const Real * u, int p, const Knots & U, Real * N )
+{
+	Real left[ p+1 ][ Lanes ], right[ p+1 ][ Lanes ], Nl[ p+1 ][ Lanes ];
+	Real saved[ Lanes ], temp[ Lanes ];
+	int j, r, l;
+
+	GEOM_COUNT( BasisFuns );
+
+	for ( l = 0; l < Lanes; l++ )
+		Nl[ 0 ][ l ] = 1.;
+	for ( j = 1; j <= p; j++ )
+	{
+		// Gather the knots of each lane
+		for ( l = 0; l < Lanes; l++ )
+		{
+			left [ j ][ l ] = u[ l ] - U[ i[ l ]+1-j ];
+			right[ j ][ l ] = U[ i[ l ]+j ] - u[ l ];
+			saved[ l ] = 0.;
+		}
+		for ( r = 0; r < j; r++ )
+		{
+			for ( l = 0; l < Lanes; l++ )
+			{
+				temp[ l ] = Nl[ r ][ l ] / ( right[ r+1 ][ l ] + left[ j-r ][ l ] );
+				Nl[ r ][ l ] = saved[ l ] + right[ r+1 ][ l ] * temp[ l ];
+				saved[ l ] = left[ j-r ][ l ] * temp[ l ];
+			}
+		}
+		for ( l = 0; l < Lanes; l++ )
+			Nl[ j ][ l ] = saved[ l ];
+	}
+
+	for ( j = 0; j <= p; j++ )
+		for ( l = 0; l < Lanes; l++ )
+			N[ j*Lanes + l ] = Nl[ j ][ l ];
+}
+
+template <int Lanes, class Real, class Knots>
+void dersBasisFunsLanes( const int * i, const Real * u, int p, int n, const Knots & U, Real * ders )
+{
+	Real ndu[ p+1 ][ p+1 ][ Lanes ], a[ 2 ][ p+1 ][ Lanes ];
+	Real left[ p+1 ][ Lanes ], right[ p+1 ][ Lanes ];
+	Real saved[ Lanes ], d[ Lanes ], temp, f;
+	int j, k, r, l, rk, pk, j1, j2, s1, s2;
+
+	GEOM_COUNT( DersBasisFuns );
+
+	for ( l = 0; l < Lanes; l++ )
+		ndu[ 0 ][ 0 ][ l ] = 1.;
+	for ( j = 1; j <= p; j++ )
+	{
+		for ( l = 0; l < Lanes; l++ )
+		{
+			left[ j ][ l ] = u[ l ] - U[ i[ l ]+1-j ];
+			right[ j ][ l ] = U[ i[ l ]+j ] - u[ l ];
+			saved[ l ] = 0.;
+		}
+		for ( r = 0; r < j; r++ )
+		{
+			for ( l = 0; l < Lanes; l++ )
+			{
+				// Lower triangle
+				ndu[ j ][ r ][ l ] = right[ r+1 ][ l ] + left[ j-r ][ l ];
+				temp = ndu[ r ][ j-1 ][ l ] / ndu[ j ][ r ][ l ];
+
+				// Upper triangle
+				ndu[ r ][ j ][ l ] = saved[ l ] + right[ r+1 ][ l ] * temp;
+				saved[ l ] = left[ j-r ][ l ] * temp;
+			}
+		}
+		for ( l = 0; l < Lanes; l++ )
+			ndu[ j ][ j ][ l ] = saved[ l ];
+	}
+
+	// Load the basis functions
+	for ( j = 0; j <= p; j++ )
+		for ( l = 0; l < Lanes; l++ )
+			ders[ j*Lanes + l ] = ndu[ j ][ p ][ l ];
+
+	// This section computes the derivatives (same control flow in every lane)
+	for ( r = 0; r <= p; r++ )
+	{
+		s1 = 0;
+		s2 = 1;
+		for ( l = 0; l < Lanes; l++ )
+			a[ 0 ][ 0 ][ l ] = 1.;
+		for ( k = 1; k <= n; k++ )
+		{
+			rk = r - k;
+			pk = p - k;
+			for ( l = 0; l < Lanes; l++ )
+				d[ l ] = 0.;
+			if ( r >= k )
+			{
+				for ( l = 0; l < Lanes; l++ )
+				{
+					a[ s2 ][ 0 ][ l ] = a[ s1 ][ 0 ][ l ] / ndu[ pk+1 ][ rk ][ l ];
+					d[ l ] = a[ s2 ][ 0 ][ l ] * ndu[ rk ][ pk ][ l ];
+				}
+			}
+			j1 = rk >= -1 ? 1 : -rk;
+			j2 = r-1 <= pk ? k - 1 : p - r;
+			for ( j = j1; j <= j2; j++ )
+			{
+				for ( l = 0; l < Lanes; l++ )
+				{
+					a[ s2 ][ j ][ l ] = ( a[ s1 ][ j ][ l ] - a[ s1 ][ j-1 ][ l ] ) / ndu[ pk+1 ][ rk+j ][ l ];
+					d[ l ] += a[ s2 ][ j ][ l ] * ndu[ rk+j ][ pk ][ l ];
+				}
+			}
+			if ( r <= pk )
+			{
+				for ( l = 0; l < Lanes; l++ )
+				{
+					a[ s2 ][ k ][ l ] = -a[ s1 ][ k-1 ][ l ] / ndu[ pk+1 ][ r ][ l ];
+					d[ l ] += a[ s2 ][ k ][ l ] * ndu[ r ][ pk ][ l ];
+				}
+			}
+			for ( l = 0; l < Lanes; l++ )
+				ders[ ( k*(p+1) + r )*Lanes + l ] = d[ l ];
+			std::swap( s1, s2 );
+		}
+	}
+
+	// Multiply through by the correct factors
+	f = p;
+	for ( k = 1; k <= n; k++ )
+	{
+		for ( j = 0; j < ( p+1 ) * Lanes; j++ )
+			ders[ k*(p+1)*Lanes + j ] *= f;
+		f *= ( p - k );
+	}
+}
+
+template <class Point, class Real>
+void rationalDerivs( Point * ders, Real * wders, int d )
+{
+	Real bin[ d+1 ];
+	int i, k;
+
+	// In place: ders[ k-i ] already holds CK[ k-i ]
+	for ( k = 0; k <= d; k++ )
+	{
+		// Row k of Pascal's triangle
+		bin[ k ] = 1;
+		for ( i = k - 1; i > 0; i-- )
+			bin[ i ] += bin[ i-1 ];
+
+		for ( i = 1; i <= k; i++ )
+			ders[ k ] -= ders[ k-i ] * ( bin[ i ] * wders[ i ] );
+		ders[ k ] /= wders[ 0 ];
+	}
+}
+
+template <class Real>
+void adjustParameter( Real & u, const Real & low, const Real & high, bool clamped )
+{
+	Real total;
+
+	if ( clamped )
+	{
+		u = std::max( u, low );
+		u = std::min( u, high );
+	}
+	else
+	{
+		total = std::fabs( high - low );
+		while ( u < low ) u += total;
+		while ( u >= high ) u -= total;
+	}
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,523 @@
+/** -*- C++ -*-
+ * @file Binary.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef IO_BINARY_HPP
+#define IO_BINARY_HPP
+
+#include "Vector.hpp"
+#include "Spline.hpp"
+#include "NURBS.hpp"
+#include "View.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define GEOM_HAVE_MMAP
+#endif
+
+/**
+ * Binary curve files.
+ *
+ * Layout (native byte order, every record aligned on 8 bytes):
+ *
+ *   FileHeader    magic "GEOMCURV", version, byte order mark,
+ *                 dimension N, sizeof( Real ), number of curves
+ *   then for each curve:
+ *   RecordHeader  degree, flags (Uniform, Clamped), knot and point counts
+ *   Real[ k ]     knot vector
+ *   Real[ n ][ N+1 ]  homogeneous control points ( w x, w y, ..., w )
+ *   padding       zeros up to the next multiple of 8 bytes
+ *
+ * A count of ~0 means "unknown" (the writer could not seek back): the
+ * reader then takes every complete record up to the end of the file.
+ */
+namespace io
+{
+
+/**
+ * @brief Curve record flags.
+ */
+enum Flags
+{
+	Uniform = 1,
+	Clamped = 2
+};
+
+/**
+ * @brief File header (32 bytes).
+ */
+struct FileHeader
+{
+	char magic[ 8 ];
+	std::uint32_t version;
+	std::uint32_t byteOrder;
+	std::uint32_t dimension;
+	std::uint32_t realSize;
+	std::uint64_t count;
+};
+
+/**
+ * @brief Curve record header (16 bytes).
+ */
+struct RecordHeader
+{
+	std::int32_t degree;
+	std::uint32_t flags;
+	std::uint32_t knots;
+	std::uint32_t points;
+};
+
+static_assert( sizeof( FileHeader ) == 32, "FileHeader must be 32 bytes" );
+static_assert( sizeof( RecordHeader ) == 16, "RecordHeader must be 16 bytes" );
+
+static const char Magic[ 8 ] = { 'G', 'E', 'O', 'M', 'C', 'U', 'R', 'V' };
+static const std::uint32_t Version = 1;
+static const std::uint32_t ByteOrder = 0x01020304;
+static const std::uint64_t UnknownCount = ~(std::uint64_t)0;
+
+/**
+ * @brief Rounds a record size up to the record alignment.
+ */
+inline std::size_t align( std::size_t size )
+{
+	return ( size + 7 ) & ~(std::size_t)7;
+}
+
+/**
+ * @brief Zero-copy view of a curve record.
+ *
+ * A NURBSView on the arrays of the record, in the mapped file (or any
+ * buffer with the same layout): it is valid as long as the memory it views.
+ */
+template <int N, class Real = float>
+class CurveView final : public curve::NURBSView<N, Real>
+{
+public:
+	CurveView() : _flags( 0 ), _points( 0 ) {}
+
+	/**
+	 * @param knots Knot vector, of size pointCount+degree+1.
+	 * @param points Homogeneous control points, of size pointCount x (N+1).
+	 */
+	CurveView( int degree, unsigned flags, const Real * knots, const Real * points, int pointCount ) :
+		curve::NURBSView<N, Real>( pointCount, degree,
+			curve::Strided<Real>( knots ),
+			curve::Strided<Real>( points, N+1 ),
+			curve::Strided<Real>( points + N, N+1 ), true, ( flags & Clamped ) != 0 ),
+		_flags( flags ), _points( points )
+	{
+		this->setUniform( ( flags & Uniform ) != 0 );
+	}
+
+	unsigned flags() const       { return _flags; }
+	int knotCount() const        { return this->_count + this->_degree + 1; }
+	int pointCount() const       { return this->_count; }
+	const Real * knots() const   { return this->_knots.data(); }
+	const Real * points() const  { return _points; }
+
+	/**
+	 * @brief Copies the curve into a NURBS.
+	 */
+	curve::NURBS<N, Real> toNURBS() const;
+
+private:
+	unsigned _flags;
+	const Real * _points;
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Falls back to reading the file into memory where mmap is not available.
+ */
+class Mapping
+{
+public:
+	/**
+	 * @throw std::runtime_error If the file cannot be opened or mapped.
+	 */
+	explicit Mapping( const std::string & path );
+	~Mapping();
+
+	Mapping( Mapping && mapping );
+	Mapping( const Mapping & ) = delete;
+	Mapping & operator=( const Mapping & ) = delete;
+
+	const char * data() const { return _data; }
+	std::size_t size() const  { return _size; }
+
+private:
+	const char * _data;
+	std::size_t _size;
+	bool _mapped;
+	std::vector<char> _buffer;
+};
+
+/**
+ * @brief Memory-mapped curve file reader.
+ *
+ * Opening the file maps it and indexes the records (one pass over their
+ * headers); curves are then returned as views into the mapping.
+ */
+template <int N, class Real = float>
+class Reader
+{
+public:
+	typedef CurveView<N, Real> View;
+
+	/**
+	 * @throw std::runtime_error If the file is not a curve file of this
+	 * dimension and real type, or is truncated.
+	 */
+	explicit Reader( const std::string & path );
+
+	/**
+	 * @brief Returns the number of curves.
+	 */
+	std::size_t size() const { return _offsets.size(); }
+
+	/**
+	 * @brief Returns a view of curve i (valid while the reader exists).
+	 */
+	View operator[]( std::size_t i ) const;
+
+	/**
+	 * @brief Copies curve i into a NURBS.
+	 */
+	curve::NURBS<N, Real> load( std::size_t i ) const { return (*this)[ i ].toNURBS(); }
+
+private:
+	Mapping _mapping;
+	std::vector<std::size_t> _offsets;
+};
+
+/**
+ * @brief Streaming curve file writer.
+ *
+ * Records are appended as they come; the curve count is written in the
+ * header when the writer is closed.
+ */
+template <int N, class Real = float>
+class Writer
+{
+public:
+	/**
+	 * @throw std::runtime_error If the file cannot be created.
+	 */
+	explicit Writer( const std::string & path );
+	~Writer() { finish(); }
+
+	Writer( const Writer & ) = delete;
+	Writer & operator=( const Writer & ) = delete;
+
+	/**
+	 * @brief Appends a curve.
+	 */
+	void write( const curve::Spline<N, Real> & curve );
+
+	/**
+	 * @brief Appends a curve view (e.g. copied from another file).
+	 */
+	void write( const CurveView<N, Real> & curve );
+
+	/**
+	 * @brief Writes the curve count and closes the file.
+	 * @throw std::runtime_error If a write failed.
+	 */
+	void close();
+
+	/**
+	 * @brief Returns the number of curves written.
+	 */
+	std::size_t size() const { return _count; }
+
+private:
+	std::ofstream _file;
+	std::size_t _count;
+	std::vector<Real> _buffer;
+
+	void writeRecord( int degree, unsigned flags, const Real * knots, std::size_t knotCount, const Real * points, std::size_t pointCount );
+
+	/**
+	 * @brief Closes the file, if open.
+	 * @return False if a write failed.
+	 */
+	bool finish();
+};
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+curve::NURBS<N, Real> CurveView<N, Real>::toNURBS() const
+{
+	std::vector<geom::WeightedPoint<N, Real> > points( pointCount() );
+	std::vector<Real> knots( this->knots(), this->knots() + knotCount() );
+	int i;
+
+	for ( i = 0; i < pointCount(); i++ )
+		points[ i ] = this->controlPoint( i );
+
+	curve::NURBS<N, Real> curve( std::move( points ), std::move( knots ), this->_degree );
+	curve.setClamped( this->isClamped() );
+	if ( this->isUniform() )
+		curve.setUniform( true );
+	return curve;
+}
+
+// -----------------------------------------------------------------------------
+
+inline Mapping::Mapping( const std::string & path ) :
+	_data( 0 ), _size( 0 ), _mapped( false )
+{
+#ifdef GEOM_HAVE_MMAP
+	struct stat st;
+	void * data;
+	int fd;
+
+	fd = ::open( path.c_str(), O_RDONLY );
+	if ( fd < 0 )
+		throw std::runtime_error( "io::Mapping: cannot open " + path );
+	if ( ::fstat( fd, &st ) != 0 )
+	{
+		::close( fd );
+		throw std::runtime_error( "io::Mapping: cannot stat " + path );
+	}
+	_size = st.st_size;
+	if ( _size > 0 )
+	{
+		data = ::mmap( 0, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if ( data == MAP_FAILED )
+		{
+			::close( fd );
+			throw std::runtime_error( "io::Mapping: cannot map " + path );
+		}
+		_data = static_cast<const char *>( data );
+		_mapped = true;
+	}
+	::close( fd );
+#else
+	std::ifstream file( path.c_str(), std::ios::binary | std::ios::ate );
+
+	if ( !file )
+		throw std::runtime_error( "io::Mapping: cannot open " + path );
+	_size = file.tellg();
+	_buffer.resize( _size );
+	file.seekg( 0 );
+	file.read( _buffer.data(), _size );
+	if ( !file )
+		throw std::runtime_error( "io::Mapping: cannot read " + path );
+	_data = _buffer.data();
+#endif
+}
+
+inline Mapping::Mapping( Mapping && mapping ) :
+	_data( mapping._data ), _size( mapping._size ), _mapped( mapping._mapped ),
+	_buffer( std::move( mapping._buffer ) )
+{
+	if ( !_mapped )
+		_data = _buffer.data();
+	mapping._data = 0;
+	mapping._size = 0;
+	mapping._mapped = false;
+}
+
+inline Mapping::~Mapping()
+{
+#ifdef GEOM_HAVE_MMAP
+	if ( _mapped )
+		::munmap( const_cast<char *>( _data ), _size );
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+Reader<N, Real>::Reader( const std::string & path ) :
+	_mapping( path )
+{
+	const char * data = _mapping.data();
+	std::size_t size = _mapping.size(), offset, length;
+	FileHeader header;
+	RecordHeader record;
+	std::uint64_t i;
+
+	if ( size < sizeof( FileHeader ) )
+		throw std::runtime_error( "io::Reader: not a curve file: " + path );
+	std::memcpy( &header, data, sizeof( FileHeader ) );
+	if ( std::memcmp( header.magic, Magic, sizeof( Magic ) ) != 0 || header.version != Version || header.byteOrder != ByteOrder )
+		throw std::runtime_error( "io::Reader: not a curve file (or other byte order): " + path );
+	if ( header.dimension != (std::uint32_t)N || header.realSize != sizeof( Real ) )
+		throw std::runtime_error( "io::Reader: dimension or real type mismatch: " + path );
+
+	if ( header.count != UnknownCount )
+		_offsets.reserve( std::min<std::uint64_t>( header.count, size / sizeof( RecordHeader ) ) );
+
+	// Index the records
+	offset = sizeof( FileHeader );
+	for ( i = 0; header.count == UnknownCount || i < header.count; i++ )
+	{
+		if ( offset + sizeof( RecordHeader ) > size )
+			break;
+		std::memcpy( &record, data + offset, sizeof( RecordHeader ) );
+		length = align( sizeof( RecordHeader ) + ( record.knots + (std::size_t)record.points * ( N+1 ) ) * sizeof( Real ) );
+		if ( offset + length > size )
+			break;
+		if ( record.degree < 0 || record.points < 1 || record.knots != record.points + record.degree + 1 )
+			throw std::runtime_error( "io::Reader: corrupt record in " + path );
+		_offsets.push_back( offset );
+		offset += length;
+	}
+	if ( header.count != UnknownCount && _offsets.size() != header.count )
+		throw std::runtime_error( "io::Reader: truncated file: " + path );
+}
+
+template <int N, class Real>
+typename Reader<N, Real>::View Reader<N, Real>::operator[]( std::size_t i ) const
+{
+	const char * record = _mapping.data() + _offsets[ i ];
+	const Real * knots = reinterpret_cast<const Real *>( record + sizeof( RecordHeader ) );
+	RecordHeader header;
+
+	std::memcpy( &header, record, sizeof( RecordHeader ) );
+	return View( header.degree, header.flags, knots, knots + header.knots, header.points );
+}
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+Writer<N, Real>::Writer( const std::string & path ) :
+	_file( path.c_str(), std::ios::binary | std::ios::trunc ), _count( 0 )
+{
+	FileHeader header;
+
+	if ( !_file )
+		throw std::runtime_error( "io::Writer: cannot create " + path );
+
+	std::memcpy( header.magic, Magic, sizeof( Magic ) );
+	header.version = Version;
+	header.byteOrder = ByteOrder;
+	header.dimension = N;
+	header.realSize = sizeof( Real );
+	header.count = UnknownCount;
+	_file.write( reinterpret_cast<const char *>( &header ), sizeof( FileHeader ) );
+}
+
+template <int N, class Real>
+void Writer<N, Real>::write( const curve::Spline<N, Real> & curve )
+{
+	const std::vector<geom::WeightedPoint<N, Real> > & P = curve.controlPoints();
+	std::size_t i;
+	int j;
+
+	// Homogeneous coordinates
+	_buffer.resize( P.size() * ( N+1 ) );
+	for ( i = 0; i < P.size(); i++ )
+	{
+		for ( j = 0; j < N; j++ )
+			_buffer[ i*(N+1) + j ] = P[ i ][ j ] * P[ i ].weight();
+		_buffer[ i*(N+1) + N ] = P[ i ].weight();
+	}
+
+	writeRecord( curve.getDegree(), ( curve.isUniform() ? Uniform : 0 ) | ( curve.isClamped() ? Clamped : 0 ),
+		curve.knotVector().data(), curve.knotVector().size(), _buffer.data(), P.size() );
+}
+
+template <int N, class Real>
+void Writer<N, Real>::write( const CurveView<N, Real> & curve )
+{
+	writeRecord( curve.getDegree(), curve.flags(), curve.knots(), curve.knotCount(), curve.points(), curve.pointCount() );
+}
+
+template <int N, class Real>
+void Writer<N, Real>::writeRecord( int degree, unsigned flags, const Real * knots, std::size_t knotCount, const Real * points, std::size_t pointCount )
+{
+	static const char zeros[ 8 ] = { 0 };
+	RecordHeader record;
+	std::size_t length;
+
+	if ( !_file.is_open() )
+		throw std::runtime_error( "io::Writer: file is closed" );
+
+	record.degree = degree;
+	record.flags = flags;
+	record.knots = knotCount;
+	record.points = pointCount;
+	length = sizeof( RecordHeader ) + ( knotCount + pointCount * ( N+1 ) ) * sizeof( Real );
+
+	_file.write( reinterpret_cast<const char *>( &record ), sizeof( RecordHeader ) );
+	_file.write( reinterpret_cast<const char *>( knots ), knotCount * sizeof( Real ) );
+	_file.write( reinterpret_cast<const char *>( points ), pointCount * ( N+1 ) * sizeof( Real ) );
+	_file.write( zeros, align( length ) - length );
+	_count++;
+}
+
+template <int N, class Real>
+void Writer<N, Real>::close()
+{
+	if ( !finish() )
+		throw std::runtime_error( "io::Writer: write error" );
+}
+
+template <int N, class Real>
+bool Writer<N, Real>::finish()
+{
+	std::uint64_t count = _count;
+	bool good;
+
+	if ( !_file.is_open() )
+		return true;
+
+	good = _file.good();
+
+	// Patch the count (left unknown if the stream cannot seek, e.g. a pipe)
+	if ( good )
+	{
+		if ( _file.seekp( offsetof( FileHeader, count ) ) )
+		{
+			_file.write( reinterpret_cast<const char *>( &count ), sizeof( count ) );
+			good = _file.good();
+		}
+		else
+			_file.clear();
+	}
+	_file.close();
+	return good && !_file.fail();
+}
+
+} // namespace
+
+#endif
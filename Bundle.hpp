@@ -0,0 +1,289 @@
+/** -*- C++ -*-
+ * @file Bundle.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef CURVE_BUNDLE_HPP
+#define CURVE_BUNDLE_HPP
+
+#include "Spline.hpp"
+#include "Basis.hpp"
+#include "Vector.hpp"
+#include "Instrument.hpp"
+#include "Dispatch.hpp"
+#include <vector>
+#include <stdexcept>
+#include <cstddef>
+#include <algorithm>
+
+namespace curve
+{
+
+/**
+ * @brief Bundle of curves sharing a degree and a knot vector.
+ *
+ * Control points are stored in homogeneous coordinates, interleaved by
+ * blocks of Lanes curves: coordinate k of point i of the curves of a block
+ * is a contiguous row of Lanes values. All curves are evaluated at the same
+ * parameter with one span search and one basis computation; the sums run
+ * along the rows (one SIMD lane per curve).
+ */
+template <int N, class Real = float>
+class Bundle
+{
+public:
+	typedef geom::Vector<N, Real> Point;
+	typedef geom::WeightedPoint<N, Real> ControlPoint;
+
+	/**
+	 * @brief Curves per block.
+	 */
+	enum { Lanes = 8 };
+
+	/**
+	 * @brief Constructor from the shape of the curves.
+	 * @param shape A curve of the bundle (only its degree, knots and
+	 * number of control points are used).
+	 */
+	explicit Bundle( const Spline<N, Real> & shape );
+
+	/**
+	 * @brief Appends a curve (same degree, knots and number of points).
+	 * @throw std::invalid_argument If the degree, the knots or the number of
+	 * points differ from those of the bundle.
+	 */
+	void push( const Spline<N, Real> & curve )
+	{
+		if ( curve.getDegree() != _degree || curve.knotVector() != _knots )
+			throw std::invalid_argument( "curve::Bundle: different degree or knots" );
+		push( curve.controlPoints() );
+	}
+
+	/**
+	 * @brief Appends a curve given by its control points.
+	 * @throw std::invalid_argument If the number of points differs from pointCount().
+	 */
+	void push( const std::vector<ControlPoint> & points );
+
+	/**
+	 * @brief Reserves storage for n curves.
+	 */
+	void reserve( std::size_t n )
+	{
+		_data.reserve( ( n + Lanes - 1 ) / Lanes * blockSize() );
+	}
+
+	/**
+	 * @brief Removes every curve.
+	 */
+	void clear()
+	{
+		_data.clear();
+		_size = 0;
+		_rational = false;
+	}
+
+	inline std::size_t size() const                { return _size; }
+	inline int getDegree() const                   { return _degree; }
+	inline int pointCount() const                  { return _pointCount; }
+	inline bool isRational() const                 { return _rational; }
+	inline const std::vector<Real> & knotVector() const { return _knots; }
+
+	/**
+	 * @brief Computes C(t) of every curve.
+	 * @param t The parameter t.
+	 * @param out Output array of size() points.
+	 */
+	void operator()( const Real & t, Point * out ) const;
+
+	/**
+	 * @brief Computes C(t) of every curve.
+	 * @param t The parameter t.
+	 * @param out Output array, resized to size().
+	 */
+	void operator()( const Real & t, std::vector<Point> & out ) const
+	{
+		out.resize( size() );
+		(*this)( t, out.data() );
+	}
+
+private:
+	std::vector<Real> _knots;
+	std::vector<Real> _data;   /**< Blocks of pointCount x (N+1) rows of Lanes values. */
+	std::size_t _size;
+	int _degree;
+	int _pointCount;
+	bool _uniform;
+	bool _clamped;
+	bool _rational;
+
+	inline std::size_t blockSize() const { return (std::size_t)_pointCount * ( N+1 ) * Lanes; }
+
+	/**
+	 * @brief Sums the p+1 rows of span of every block.
+	 * @param N_ The p+1 basis functions.
+	 */
+	inline void evaluateBlocks( int span, const Real * N_, Point * out ) const;
+
+#ifdef GEOM_HAVE_DISPATCH
+	GEOM_TARGET( "avx2,fma" )
+	void evaluateAVX2( int span, const Real * N_, Point * out ) const { evaluateBlocks( span, N_, out ); }
+
+	GEOM_TARGET( "avx512f,avx512vl,avx512bw,avx512dq" )
+	void evaluateAVX512( int span, const Real * N_, Point * out ) const { evaluateBlocks( span, N_, out ); }
+#endif
+};
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+Bundle<N, Real>::Bundle( const Spline<N, Real> & shape ) :
+	_knots( shape.knotVector() ),
+	_data(),
+	_size( 0 ),
+	_degree( shape.getDegree() ),
+	_pointCount( shape.controlPoints().size() ),
+	_uniform( shape.isUniform() ),
+	_clamped( shape.isClamped() ),
+	_rational( false )
+{
+}
+
+template <int N, class Real>
+void Bundle<N, Real>::push( const std::vector<ControlPoint> & points )
+{
+	std::size_t lane;
+	Real * block;
+	int i, k;
+
+	if ( (int)points.size() != _pointCount )
+		throw std::invalid_argument( "curve::Bundle: wrong number of control points" );
+
+	// New block, with unit weights in the unused lanes
+	lane = _size % Lanes;
+	if ( lane == 0 )
+	{
+		_data.resize( _data.size() + blockSize(), 0. );
+		block = &_data[ _data.size() - blockSize() ];
+		for ( i = 0; i < _pointCount; i++ )
+			std::fill( block + ( i*(N+1) + N ) * Lanes, block + ( i*(N+1) + N+1 ) * Lanes, (Real)1 );
+	}
+	block = &_data[ _data.size() - blockSize() ];
+
+	for ( i = 0; i < _pointCount; i++ )
+	{
+		const ControlPoint & P = points[ i ];
+		for ( k = 0; k < N; k++ )
+			block[ ( i*(N+1) + k ) * Lanes + lane ] = P[ k ] * P.weight();
+		block[ ( i*(N+1) + N ) * Lanes + lane ] = P.weight();
+		_rational = _rational || P.weight() != 1;
+	}
+	_size++;
+}
+
+template <int N, class Real>
+void Bundle<N, Real>::operator()( const Real & t, Point * out ) const
+{
+	Real N_[ _degree+1 ];
+	Real u = t;
+	int span, p, n;
+
+	GEOM_SCOPE( CurvePoint );
+
+	p = _degree;
+	n = _pointCount - 1;
+
+	// One span search and basis computation for every curve
+	basis::adjustParameter( u, _knots.front(), _knots.back(), _clamped );
+	span = _uniform ? basis::uniformSpan( n, p, u, _knots ) : basis::findSpan( n, p, u, _knots );
+	basis::basisFuns( span, u, p, _knots.data(), N_ );
+
+	switch ( geom::cpu::isa() )
+	{
+#ifdef GEOM_HAVE_DISPATCH
+	case geom::cpu::AVX512: evaluateAVX512( span, N_, out ); break;
+	case geom::cpu::AVX2:   evaluateAVX2( span, N_, out ); break;
+#endif
+	default:                evaluateBlocks( span, N_, out ); break;
+	}
+}
+
+template <int N, class Real>
+inline void Bundle<N, Real>::evaluateBlocks( int span, const Real * N_, Point * out ) const
+{
+	Real Cw[ N+1 ][ Lanes ];
+	const Real * row;
+	std::size_t b, blocks, lane, lanes;
+	int p, j, k, l;
+
+	p = _degree;
+	blocks = ( _size + Lanes - 1 ) / Lanes;
+	for ( b = 0; b < blocks; b++ )
+	{
+		// Rows of the p+1 points are contiguous
+		row = &_data[ b * blockSize() ] + ( span - p ) * (N+1) * Lanes;
+		for ( k = 0; k <= N; k++ )
+		{
+			for ( l = 0; l < Lanes; l++ )
+				Cw[ k ][ l ] = 0.;
+			for ( j = 0; j <= p; j++ )
+				for ( l = 0; l < Lanes; l++ )
+					Cw[ k ][ l ] += N_[ j ] * row[ ( j*(N+1) + k ) * Lanes + l ];
+		}
+
+		// Divide by weight (partition of unity otherwise)
+		if ( _rational )
+		{
+			for ( k = 0; k < N; k++ )
+				for ( l = 0; l < Lanes; l++ )
+					Cw[ k ][ l ] /= Cw[ N ][ l ];
+		}
+
+		lanes = std::min( (std::size_t)Lanes, _size - b * Lanes );
+		for ( lane = 0; lane < lanes; lane++ )
+			for ( k = 0; k < N; k++ )
+				out[ b * Lanes + lane ][ k ] = Cw[ k ][ lane ];
+	}
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace curve
+{
+
+extern template class Bundle<2, float>;
+extern template class Bundle<3, float>;
+extern template class Bundle<4, float>;
+extern template class Bundle<2, double>;
+extern template class Bundle<3, double>;
+extern template class Bundle<4, double>;
+
+} // namespace
+#endif
+
+#endif
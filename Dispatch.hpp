@@ -0,0 +1,158 @@
+/** -*- C++ -*-
+ * @file Dispatch.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef GEOM_DISPATCH_HPP
+#define GEOM_DISPATCH_HPP
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @brief Compiles a function for an instruction set (x86, GCC and Clang).
+ *
+ * Callees are inlined (flatten), so that the whole kernel uses the
+ * instruction set, e.g. GEOM_TARGET( "avx2,fma" ).
+ */
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define GEOM_HAVE_DISPATCH
+#define GEOM_TARGET( isa ) __attribute__(( target( isa ), flatten ))
+#else
+#define GEOM_TARGET( isa )
+#endif
+
+namespace geom
+{
+
+namespace cpu
+{
+
+/**
+ * @brief Instruction sets of the dispatched kernels, in increasing order.
+ *
+ * Kernels have AVX2 and AVX-512 variants: the same loops, vectorized over
+ * 256 or 512-bit registers with FMA. SSE 4.2 adds nothing these floating
+ * point loops use over SSE2, so it runs the generic kernels.
+ */
+enum Isa
+{
+	Generic, /**< Compiler defaults (SSE2 on x86-64). */
+	SSE42,   /**< Generic kernels. */
+	AVX2,    /**< AVX2 and FMA. */
+	AVX512,  /**< AVX-512 F, VL, BW and DQ. */
+	NumIsas
+};
+
+/**
+ * @brief Returns the name of an instruction set.
+ */
+inline const char * name( Isa isa )
+{
+	static const char * names[ NumIsas ] = { "generic", "sse4.2", "avx2", "avx512" };
+	return names[ isa ];
+}
+
+/**
+ * @brief Checks if the host runs an instruction set.
+ */
+inline bool supports( Isa isa )
+{
+#ifdef GEOM_HAVE_DISPATCH
+	switch ( isa )
+	{
+	case Generic: return true;
+	case SSE42:   return __builtin_cpu_supports( "sse4.2" );
+	case AVX2:    return __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" );
+	case AVX512:  return __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512vl" ) &&
+	                     __builtin_cpu_supports( "avx512bw" ) && __builtin_cpu_supports( "avx512dq" );
+	default:      return false;
+	}
+#else
+	return isa == Generic;
+#endif
+}
+
+/**
+ * @brief Returns the best instruction set of the host (detected once).
+ */
+inline Isa best()
+{
+	static const Isa detected = []
+	{
+		int isa = NumIsas - 1;
+
+		while ( isa > Generic && !supports( (Isa)isa ) )
+			isa--;
+		return (Isa)isa;
+	}();
+	return detected;
+}
+
+/**
+ * @brief Active instruction set, initialized from the host and GEOM_ISA.
+ */
+inline std::atomic<int> & active()
+{
+	static std::atomic<int> isa( [] () -> int
+	{
+		const char * env = std::getenv( "GEOM_ISA" );
+		int i;
+
+		// Override, ignored when the host does not support it
+		for ( i = 0; env && i < NumIsas; i++ )
+			if ( std::strcmp( env, name( (Isa)i ) ) == 0 && supports( (Isa)i ) )
+				return i;
+		return best();
+	}() );
+	return isa;
+}
+
+/**
+ * @brief Returns the instruction set the kernels dispatch to.
+ */
+inline Isa isa()
+{
+	return (Isa)active().load( std::memory_order_relaxed );
+}
+
+/**
+ * @brief Forces an instruction set (e.g. to benchmark each variant).
+ * @return False, and nothing changed, if the host does not support it.
+ */
+inline bool setIsa( Isa isa )
+{
+	if ( isa < Generic || isa >= NumIsas || !supports( isa ) )
+		return false;
+	active().store( isa, std::memory_order_relaxed );
+	return true;
+}
+
+} // namespace
+
+} // namespace
+
+#endif
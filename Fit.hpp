@@ -0,0 +1,261 @@
+/** -*- C++ -*-
+ * @file Fit.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef CURVE_FIT_HPP
+#define CURVE_FIT_HPP
+
+#include "NURBS.hpp"
+#include "Basis.hpp"
+#include "Band.hpp"
+#include "Vector.hpp"
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+namespace curve
+{
+
+/**
+ * @brief Chord length parameters of a sequence of points.
+ * @param Q The points.
+ * @return Parameters from 0 to 1, spaced as the distances between points
+ * (uniform if every point is the same).
+ * @see Equations 9.4 and 9.5, page 365, The NURBS Book (Springer 1997).
+ */
+template <int N, class Real>
+std::vector<Real> chordLength( const std::vector<geom::Vector<N, Real> > & Q );
+
+/**
+ * @brief Global curve interpolation.
+ *
+ * The knot vector averages the parameters, so that the collocation matrix
+ * is banded (bandwidth below p): O(n) memory and time.
+ * @param Q The points to interpolate, at least degree+1.
+ * @param u Parameters of the points, increasing from 0 to 1.
+ * @param degree Degree of the curve.
+ * @return The curve through Q (non-uniform, clamped).
+ * @throw std::invalid_argument If there are too few points.
+ * @throw std::runtime_error If the system is singular (repeated parameters).
+ * @see Algorithm A9.1, page 369, The NURBS Book (Springer 1997).
+ */
+template <int N, class Real>
+NURBS<N, Real> interpolate( const std::vector<geom::Vector<N, Real> > & Q, const std::vector<Real> & u, int degree = 3 );
+
+/**
+ * @brief Global curve interpolation at chord length parameters.
+ */
+template <int N, class Real>
+NURBS<N, Real> interpolate( const std::vector<geom::Vector<N, Real> > & Q, int degree = 3 )
+{
+	return interpolate( Q, chordLength( Q ), degree );
+}
+
+/**
+ * @brief Least squares curve approximation.
+ *
+ * The curve goes through the first and last points and approximates the
+ * others. The normal equations are banded (bandwidth p): O(m + n) memory
+ * and time for m points and n control points.
+ * @param Q The points to approximate.
+ * @param u Parameters of the points, increasing from 0 to 1.
+ * @param count Number of control points, degree+1 <= count <= Q.size().
+ * @param degree Degree of the curve.
+ * @return The approximating curve (non-uniform, clamped).
+ * @throw std::invalid_argument If count is out of range.
+ * @throw std::runtime_error If the system is singular (a knot span holds
+ * no parameter).
+ * @see Algorithm A9.7 and equation 9.69, pages 410-412, The NURBS Book (Springer 1997).
+ */
+template <int N, class Real>
+NURBS<N, Real> approximate( const std::vector<geom::Vector<N, Real> > & Q, const std::vector<Real> & u, int count, int degree = 3 );
+
+/**
+ * @brief Least squares curve approximation at chord length parameters.
+ */
+template <int N, class Real>
+NURBS<N, Real> approximate( const std::vector<geom::Vector<N, Real> > & Q, int count, int degree = 3 )
+{
+	return approximate( Q, chordLength( Q ), count, degree );
+}
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+std::vector<Real> chordLength( const std::vector<geom::Vector<N, Real> > & Q )
+{
+	std::vector<Real> u( Q.size() );
+	Real total;
+	std::size_t k, n;
+
+	if ( Q.empty() )
+		return u;
+
+	n = Q.size() - 1;
+	total = 0.;
+	u[ 0 ] = 0.;
+	for ( k = 1; k <= n; k++ )
+	{
+		total += ( Q[ k ] - Q[ k-1 ] ).length();
+		u[ k ] = total;
+	}
+
+	for ( k = 1; k <= n; k++ )
+		u[ k ] = total > 0 ? u[ k ] / total : k / (Real)n;
+	u[ n ] = 1.;
+	return u;
+}
+
+template <int N, class Real>
+NURBS<N, Real> interpolate( const std::vector<geom::Vector<N, Real> > & Q, const std::vector<Real> & u, int degree )
+{
+	std::vector<geom::Vector<N, Real> > P( Q );
+	std::vector<Real> U;
+	Real sum;
+	int n, p, j, k, span;
+
+	p = degree;
+	n = (int)Q.size() - 1;
+	if ( p < 1 || n < p || u.size() != Q.size() )
+		throw std::invalid_argument( "curve::interpolate: needs degree+1 points and parameters" );
+
+	// Knots by averaging (equation 9.8), sliding sum of p parameters
+	U.assign( n+p+2, 0. );
+	sum = 0.;
+	for ( k = 1; k < p; k++ )
+		sum += u[ k ];
+	for ( j = 1; j <= n-p; j++ )
+	{
+		sum += u[ j+p-1 ];
+		U[ j+p ] = sum / p;
+		sum -= u[ j ];
+	}
+	for ( j = n+1; j <= n+p+1; j++ )
+		U[ j ] = 1.;
+
+	// Collocation matrix, one row of p+1 basis functions per point
+	geom::BandMatrix<Real> A( n+1, p, p );
+	Real N_[ p+1 ];
+	span = p;
+	for ( k = 0; k <= n; k++ )
+	{
+		while ( span < n && u[ k ] >= U[ span+1 ] )
+			span++;
+		basis::basisFuns( span, u[ k ], p, U.data(), N_ );
+		for ( j = 0; j <= p; j++ )
+			if ( A.inBand( k, span-p+j ) )
+				A( k, span-p+j ) = N_[ j ];
+	}
+
+	if ( !A.factorize() )
+		throw std::runtime_error( "curve::interpolate: singular system" );
+	A.solve( P.data() );
+
+	return NURBS<N, Real>( P, U, p );
+}
+
+template <int N, class Real>
+NURBS<N, Real> approximate( const std::vector<geom::Vector<N, Real> > & Q, const std::vector<Real> & u, int count, int degree )
+{
+	typedef geom::Vector<N, Real> Point;
+	std::vector<Point> P, R;
+	std::vector<Real> U;
+	Point Rk;
+	Real d, alpha;
+	int n, m, p, i, j, k, a, b, span;
+
+	p = degree;
+	n = count - 1;
+	m = (int)Q.size() - 1;
+	if ( p < 1 || n < p || n > m || u.size() != Q.size() )
+		throw std::invalid_argument( "curve::approximate: needs degree+1 <= count <= points" );
+
+	// Knots spread so that every span holds parameters (equation 9.69)
+	U.assign( n+p+2, 0. );
+	d = ( m+1 ) / (Real)( n-p+1 );
+	for ( j = 1; j <= n-p; j++ )
+	{
+		i = (int)( j*d );
+		alpha = j*d - i;
+		U[ p+j ] = ( 1 - alpha ) * u[ i-1 ] + alpha * u[ i ];
+	}
+	for ( j = n+1; j <= n+p+1; j++ )
+		U[ j ] = 1.;
+
+	// End points are interpolated
+	P.resize( n+1 );
+	P[ 0 ] = Q[ 0 ];
+	P[ n ] = Q[ m ];
+
+	// Normal equations of the n-1 inner points, accumulated point by point
+	geom::BandMatrix<Real> A( std::max( n-1, 0 ), p, p );
+	Real N_[ p+1 ];
+	R.assign( std::max( n-1, 0 ), Point() );
+	span = p;
+	for ( k = 1; k < m; k++ )
+	{
+		while ( span < n && u[ k ] >= U[ span+1 ] )
+			span++;
+		basis::basisFuns( span, u[ k ], p, U.data(), N_ );
+
+		Rk = Q[ k ];
+		for ( j = 0; j <= p; j++ )
+		{
+			if ( span-p+j == 0 )
+				Rk -= Q[ 0 ] * N_[ j ];
+			if ( span-p+j == n )
+				Rk -= Q[ m ] * N_[ j ];
+		}
+
+		for ( a = 0; a <= p; a++ )
+		{
+			i = span-p+a;
+			if ( i < 1 || i > n-1 )
+				continue;
+			R[ i-1 ] += Rk * N_[ a ];
+			for ( b = 0; b <= p; b++ )
+			{
+				j = span-p+b;
+				if ( j >= 1 && j <= n-1 )
+					A( i-1, j-1 ) += N_[ a ] * N_[ b ];
+			}
+		}
+	}
+
+	if ( n > 1 )
+	{
+		if ( !A.factorize() )
+			throw std::runtime_error( "curve::approximate: singular system" );
+		A.solve( R.data() );
+		std::copy( R.begin(), R.end(), P.begin() + 1 );
+	}
+
+	return NURBS<N, Real>( P, U, p );
+}
+
+} // namespace
+
+#endif
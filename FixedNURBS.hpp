@@ -0,0 +1,241 @@
+/** -*- C++ -*-
+ * @file FixedNURBS.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef CURVE_FIXED_NURBS_HPP
+#define CURVE_FIXED_NURBS_HPP
+
+#include "Vector.hpp"
+#include <cassert>
+
+namespace curve
+{
+
+/**
+ * @brief Fixed-capacity NURBS curve class template.
+ *
+ * A NURBS curve of at most Capacity control points, stored inline (no
+ * allocation, no virtual call), so that it is a literal type: a curve
+ * with constant control points can be declared constexpr and sampled at
+ * compile time, e.g.
+ *
+ *   constexpr geom::Vector<2, double> P[] = { ... };
+ *   constexpr curve::FixedNURBS<2, 8, double> c( P, 4, 3 );
+ *   constexpr auto table = c.sample<64>( 0., 1. );
+ *
+ * Points match NURBS<N, Real>::operator() for the same control points
+ * and knots.
+ */
+template <int N, int Capacity, class Real = float>
+class FixedNURBS
+{
+public:
+	typedef Real Type;
+	typedef geom::Vector<N, Real> Point;
+	typedef geom::WeightedPoint<N, Real> ControlPoint;
+
+	enum { KnotCapacity = 2 * Capacity };
+
+	/**
+	 * @brief Points at regular parameters, computed by sample().
+	 */
+	template <int Count>
+	struct Samples
+	{
+		Point points[ Count ];
+
+		constexpr const Point & operator[]( int i ) const { return points[ i ]; }
+		constexpr int size() const { return Count; }
+	};
+
+	/**
+	 * @brief Constructor for uniform clamped curves.
+	 * @param points Control points (count elements).
+	 * @param count Number of control points, at most Capacity.
+	 * @param degree Degree of the curve, below count.
+	 */
+	constexpr FixedNURBS( const ControlPoint * points, int count, int degree = 3 ) :
+		_points(), _knots(), _count( count ), _degree( degree )
+	{
+		setControlPoints( points );
+		computeUniformKnotVector();
+	}
+
+	/**
+	 * @brief Constructor for uniform clamped non-rational curves (weights 1).
+	 */
+	constexpr FixedNURBS( const Point * points, int count, int degree = 3 ) :
+		_points(), _knots(), _count( count ), _degree( degree )
+	{
+		setControlPoints( points );
+		computeUniformKnotVector();
+	}
+
+	/**
+	 * @brief Constructor with a knot vector.
+	 * @param points Control points (count elements).
+	 * @param count Number of control points, at most Capacity.
+	 * @param knots Knot vector (count + degree + 1 elements, clamped).
+	 * @param degree Degree of the curve, below count.
+	 */
+	constexpr FixedNURBS( const ControlPoint * points, int count, const Real * knots, int degree = 3 ) :
+		_points(), _knots(), _count( count ), _degree( degree )
+	{
+		setControlPoints( points );
+		for ( int i = 0; i < count + degree + 1; i++ )
+			_knots[ i ] = knots[ i ];
+	}
+
+	constexpr int size() const { return _count; }
+	constexpr int getDegree() const { return _degree; }
+	constexpr const ControlPoint & controlPoint( int i ) const { return _points[ i ]; }
+	constexpr const Real & knot( int i ) const { return _knots[ i ]; }
+
+	/**
+	 * @brief Computes C(t).
+	 * @param t The parameter t (clamped to the domain of the knots).
+	 * @return The computed point.
+	 * @see Algorithm A4.1, page 124, The NURBS Book (Springer 1997).
+	 */
+	constexpr Point operator()( const Real & t ) const
+	{
+		Real Nb[ Capacity ] = {}, Cw[ N ] = {};
+		Real u = t, w = 0, Nw = 0;
+		int p = _degree, span = 0, j = 0, k = 0;
+		Point C;
+
+		if ( u < _knots[ p ] ) u = _knots[ p ];
+		if ( u > _knots[ _count ] ) u = _knots[ _count ];
+
+		span = findSpan( u );
+		basisFuns( span, u, Nb );
+
+		for ( j = 0; j <= p; j++ )
+		{
+			const ControlPoint & Pi = _points[ span-p+j ];
+			Nw = Nb[ j ] * Pi.weight();
+			for ( k = 0; k < N; k++ )
+				Cw[ k ] += Nw * Pi[ k ];
+			w += Nw;
+		}
+		for ( k = 0; k < N; k++ )
+			C[ k ] = Cw[ k ] / w;
+		return C;
+	}
+
+	/**
+	 * @brief Computes Count points at regular parameters from t0 to t1.
+	 */
+	template <int Count>
+	constexpr Samples<Count> sample( const Real & t0, const Real & t1 ) const
+	{
+		Samples<Count> s;
+
+		for ( int i = 0; i < Count; i++ )
+			s.points[ i ] = (*this)( Count > 1 ? t0 + ( t1 - t0 ) * i / (Real)( Count - 1 ) : t0 );
+		return s;
+	}
+
+private:
+	template <class PointType>
+	constexpr void setControlPoints( const PointType * points )
+	{
+		assert( _degree >= 0 && _degree < _count && _count <= Capacity );
+
+		for ( int i = 0; i < _count; i++ )
+			_points[ i ] = ControlPoint( points[ i ] );
+	}
+
+	/**
+	 * @brief Computes a uniform clamped knot vector (as Spline).
+	 */
+	constexpr void computeUniformKnotVector()
+	{
+		int i = 0;
+
+		for ( /* */; i <= _degree; i++ ) _knots[ i ] = 0;
+		for ( /* */; i < _count; i++ ) _knots[ i ] = (Real)( i - _degree ) / (Real)( _count - _degree );
+		for ( /* */; i < _count + _degree + 1; i++ ) _knots[ i ] = 1;
+	}
+
+	/**
+	 * @see basis::findSpan (not counted by the instrumentation).
+	 */
+	constexpr int findSpan( const Real & u ) const
+	{
+		int n = _count - 1, p = _degree, low = 0, high = 0, mid = 0;
+
+		if ( u <= _knots[ p ] ) return p;
+		if ( u >= _knots[ n+1 ] ) return n;
+
+		low = p;
+		high = n + 1;
+		mid = ( low + high ) / 2;
+		while ( u < _knots[ mid ] || u >= _knots[ mid+1 ] )
+		{
+			if ( u < _knots[ mid ] )
+				high = mid;
+			else
+				low = mid;
+			mid = ( low + high ) / 2;
+		}
+		return mid;
+	}
+
+	/**
+	 * @see basis::basisFuns (fixed-size arrays instead of VLAs).
+	 */
+	constexpr void basisFuns( int i, const Real & u, Real * Nb ) const
+	{
+		Real left[ Capacity ] = {}, right[ Capacity ] = {};
+		Real saved = 0, temp = 0;
+		int j = 0, r = 0;
+
+		Nb[ 0 ] = 1;
+		for ( j = 1; j <= _degree; j++ )
+		{
+			left [ j ] = u - _knots[ i+1-j ];
+			right[ j ] = _knots[ i+j ] - u;
+			saved = 0;
+			for ( r = 0; r < j; r++ )
+			{
+				temp = Nb[ r ] / ( right[ r+1 ] + left[ j-r ] );
+				Nb[ r ] = saved + right[ r+1 ] * temp;
+				saved = left[ j-r ] * temp;
+			}
+			Nb[ j ] = saved;
+		}
+	}
+
+	ControlPoint _points[ Capacity ];
+	Real _knots[ KnotCapacity ];
+	int _count;
+	int _degree;
+};
+
+} // namespace
+
+#endif
@@ -27,7 +27,8 @@
 #ifndef FRAME_HPP
 #define FRAME_HPP
 
-#include <functional>
+#include "Functional.hpp"
+#include <memory>
 #include "Parametric.hpp"
 #include "Vector.hpp"
 #include "Matrix.hpp"
@@ -41,48 +42,55 @@ namespace frame
  * A class to compute the various frames based on curves.
  */
 template <int N, class Real = float>
-class Curve : public std::unary_function<Real, geom::Matrix<N, N, Real> >
+class Curve : public geom::UnaryFunction<Real, geom::Matrix<N, N, Real> >
 {
 public:
+	typedef std::shared_ptr<const curve::Parametric<N, Real> > CurvePointer;
+
 	/**
 	 * @brief Empty constructor.
 	 */
 	Curve() :
-		_curve( 0 )
+		_curve()
 	{
 	}
 
 	/**
-	 * @brief Constructor from a curve (which is cloned).
+	 * @brief Constructor from a curve.
+	 *
+	 * A curve object is copied once; a std::shared_ptr is shared without copy.
 	 * @param curve The axial curve.
 	 */
 	template <class CurveType>
 	Curve( const CurveType & curve ) :
-		_curve( new CurveType( curve ) )
+		_curve( curve::share( curve ) )
 	{
 	}
 
+	Curve( const Curve & ) = default;
+	Curve( Curve && ) = default;
+	Curve & operator=( const Curve & ) = default;
+	Curve & operator=( Curve && ) = default;
+
 	/**
-	 * @brief Deletes the cloned curve.
+	 * @brief Destructor.
 	 */
-	~Curve()
+	virtual ~Curve()
 	{
-		if ( _curve ) delete _curve;
 	}
 
 	/**
-	 * @brief Returns a pointer to the cloned curve.
+	 * @brief Returns the shared curve.
 	 */
-	inline const curve::Parametric<N, Real> * getCurve() const { return _curve; }
+	inline const CurvePointer & getCurve() const { return _curve; }
 
 	/**
-	 * @brief Removes the old curve and clones a new curve.
+	 * @brief Replaces the curve (copied once, or shared).
 	 */
 	template <class CurveType>
 	void setCurve( const CurveType & curve )
 	{
-		if ( _curve ) delete _curve;
-		_curve = new CurveType( curve );
+		_curve = curve::share( curve );
 	}
 
 	/**
@@ -93,9 +101,25 @@ public:
 	virtual geom::Matrix<N, N, Real> operator() ( const Real& t ) const = 0;
 
 private:
-	const curve::Parametric<N, Real> * _curve;
+	CurvePointer _curve;
 };
 
 } // namespace
 
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace frame
+{
+
+extern template class Curve<2, float>;
+extern template class Curve<3, float>;
+extern template class Curve<4, float>;
+extern template class Curve<2, double>;
+extern template class Curve<3, double>;
+extern template class Curve<4, double>;
+
+} // namespace
+#endif
+
 #endif
@@ -31,10 +31,46 @@
 #include "Vector.hpp"
 #include "Matrix.hpp"
 #include "Frame.hpp"
+#include "Instrument.hpp"
+#include <type_traits>
 
 namespace frame
 {
 
+/**
+ * @brief Computes the Frenet frame of a curve.
+ *
+ * The curve is evaluated with curve::Static<CurveType>.
+ * @param curve The axial curve.
+ * @param t The parameter t along the curve.
+ * @return The computed frame (Matrix 3x3, columns are T, N, B).
+ */
+template <class CurveType>
+inline geom::Matrix<3, 3, typename CurveType::Type> frenet( const CurveType & curve, const typename CurveType::Type& t )
+{
+	typedef typename CurveType::Type Real;
+
+	geom::Matrix<3, 3, Real> r;
+	geom::Vector<3, Real> v[ 3 ];
+	geom::Vector<3, Real> d, a;
+
+	GEOM_SCOPE( Frenet );
+
+	d = curve::Static<CurveType>::derivative( curve, t, 1 );
+	a = curve::Static<CurveType>::derivative( curve, t, 2 );
+
+	v[ 0 ] = d;
+	v[ 1 ] = d ^ ( a ^ d );
+	v[ 2 ] = d ^ a;
+
+	v[ 0 ].normalize();
+	v[ 1 ].normalize();
+	v[ 2 ].normalize();
+
+	r.setColumns( v );
+	return r;
+}
+
 /**
  * @brief Frenet frame generator class.
  *
@@ -73,26 +109,74 @@ public:
 		if ( this->getCurve() == 0 )
 			return geom::Matrix<3, 3, Real>();
 
-		geom::Matrix<3, 3, Real> r;
-		geom::Vector<3, Real> v[ 3 ];
-		geom::Vector<3, Real> d, a;
+		return frenet( *this->getCurve(), t );
+	}
+};
 
-		d = this->getCurve()->derivative( t, 1 );
-		a = this->getCurve()->derivative( t, 2 );
+/**
+ * @brief Statically dispatched Frenet frame generator class.
+ *
+ * Same frame as Frenet, but bound to a concrete curve type so that the curve
+ * evaluation is not virtual and can be inlined.
+ */
+template <class CurveType>
+class StaticFrenet : public geom::UnaryFunction<typename CurveType::Type, geom::Matrix<3, 3, typename CurveType::Type> >
+{
+public:
+	typedef typename CurveType::Type Real;
+	typedef std::shared_ptr<const CurveType> CurvePointer;
 
-		v[ 0 ] = d;
-		v[ 1 ] = d ^ ( a ^ d );
-		v[ 2 ] = d ^ a;
+	/**
+	 * @brief Empty constructor.
+	 */
+	StaticFrenet() :
+		_curve()
+	{
+	}
 
-		v[ 0 ].normalize();
-		v[ 1 ].normalize();
-		v[ 2 ].normalize();
+	/**
+	 * @brief Constructor from a curve (copied once, or shared).
+	 * @param curve The axial curve, of type CurveType (not a derived type).
+	 */
+	template <class Type>
+	StaticFrenet( const Type & curve ) :
+		_curve( curve::share( curve ) )
+	{
+		static_assert( std::is_same<typename curve::Shared<Type>::Object, CurveType>::value,
+			"frame::StaticFrenet: the curve must be a CurveType" );
+	}
 
-		r.setColumns( v );
-		return r;
+	/**
+	 * @brief Returns the shared curve.
+	 */
+	inline const CurvePointer & getCurve() const { return _curve; }
+
+	/**
+	 * @brief Computes the frame.
+	 * @param t The parameter t along the curve.
+	 * @return The computed frame (Matrix 3x3).
+	 */
+	inline geom::Matrix<3, 3, Real> operator() ( const Real& t ) const
+	{
+		return frenet( *_curve, t );
 	}
+
+private:
+	CurvePointer _curve;
 };
 
 } // namespace
 
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace frame
+{
+
+extern template class Frenet<float>;
+extern template class Frenet<double>;
+
+} // namespace
+#endif
+
 #endif
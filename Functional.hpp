@@ -0,0 +1,61 @@
+/** -*- C++ -*-
+ * @file Functional.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef GEOM_FUNCTIONAL_HPP
+#define GEOM_FUNCTIONAL_HPP
+
+namespace geom
+{
+
+/**
+ * @brief Base class of unary functors.
+ *
+ * Same typedefs as std::unary_function (deprecated since C++11).
+ */
+template <class Arg, class Result>
+struct UnaryFunction
+{
+	typedef Arg argument_type;
+	typedef Result result_type;
+};
+
+/**
+ * @brief Base class of binary functors.
+ *
+ * Same typedefs as std::binary_function (deprecated since C++11).
+ */
+template <class Arg1, class Arg2, class Result>
+struct BinaryFunction
+{
+	typedef Arg1 first_argument_type;
+	typedef Arg2 second_argument_type;
+	typedef Result result_type;
+};
+
+} // namespace
+
+#endif
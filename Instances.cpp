@@ -0,0 +1,190 @@
+/**
+ * @file Instances.cpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Explicit instantiations of the common types, compiled once into the
+ * geom_instances library. Translation units linked against it see the
+ * matching "extern template" declarations (GEOM_EXTERN_TEMPLATES) and do not
+ * instantiate these types again.
+ */
+
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Algebra.hpp"
+#include "Band.hpp"
+#include "Transform.hpp"
+#include "Quaternion.hpp"
+#include "Parametric.hpp"
+#include "Spline.hpp"
+#include "NURBS.hpp"
+#include "View.hpp"
+#include "Sampling.hpp"
+#include "Bundle.hpp"
+#include "Frame.hpp"
+#include "Frenet.hpp"
+#include "Table.hpp"
+#include "Tube.hpp"
+#include "Sweep.hpp"
+#include "Intersection.hpp"
+
+namespace geom
+{
+
+template class Vector<2, float>;
+template class Vector<3, float>;
+template class Vector<4, float>;
+template class Vector<2, double>;
+template class Vector<3, double>;
+template class Vector<4, double>;
+template class WeightedPoint<2, float>;
+template class WeightedPoint<3, float>;
+template class WeightedPoint<4, float>;
+template class WeightedPoint<2, double>;
+template class WeightedPoint<3, double>;
+template class WeightedPoint<4, double>;
+
+template class Matrix<2, 2, float>;
+template class Matrix<3, 3, float>;
+template class Matrix<4, 4, float>;
+template class Matrix<2, 2, double>;
+template class Matrix<3, 3, double>;
+template class Matrix<4, 4, double>;
+
+template struct Square<2, float>;
+template struct Square<3, float>;
+template struct Square<4, float>;
+template struct Square<2, double>;
+template struct Square<3, double>;
+template struct Square<4, double>;
+
+template struct Batch<2, 2, float>;
+template struct Batch<3, 3, float>;
+template struct Batch<4, 4, float>;
+template struct Batch<2, 2, double>;
+template struct Batch<3, 3, double>;
+template struct Batch<4, 4, double>;
+
+template class Quaternion<float>;
+template class Quaternion<double>;
+
+template class BandMatrix<float>;
+template class BandMatrix<double>;
+
+} // namespace
+
+namespace curve
+{
+
+template class Parametric<2, float>;
+template class Parametric<3, float>;
+template class Parametric<4, float>;
+template class Parametric<2, double>;
+template class Parametric<3, double>;
+template class Parametric<4, double>;
+
+template class Spline<2, float>;
+template class Spline<3, float>;
+template class Spline<4, float>;
+template class Spline<2, double>;
+template class Spline<3, double>;
+template class Spline<4, double>;
+
+template class NURBS<2, float>;
+template class NURBS<3, float>;
+template class NURBS<4, float>;
+template class NURBS<2, double>;
+template class NURBS<3, double>;
+template class NURBS<4, double>;
+template class NURBS<2, float, double>;
+template class NURBS<3, float, double>;
+template class NURBS<4, float, double>;
+
+template class SplineView<2, float>;
+template class SplineView<3, float>;
+template class SplineView<4, float>;
+template class SplineView<2, double>;
+template class SplineView<3, double>;
+template class SplineView<4, double>;
+
+template class SamplingPlan<2, float>;
+template class SamplingPlan<3, float>;
+template class SamplingPlan<4, float>;
+template class SamplingPlan<2, double>;
+template class SamplingPlan<3, double>;
+template class SamplingPlan<4, double>;
+
+template class Bundle<2, float>;
+template class Bundle<3, float>;
+template class Bundle<4, float>;
+template class Bundle<2, double>;
+template class Bundle<3, double>;
+template class Bundle<4, double>;
+
+} // namespace
+
+namespace frame
+{
+
+template class Curve<2, float>;
+template class Curve<3, float>;
+template class Curve<4, float>;
+template class Curve<2, double>;
+template class Curve<3, double>;
+template class Curve<4, double>;
+
+template class Frenet<float>;
+template class Frenet<double>;
+template class Table<float>;
+template class Table<double>;
+
+} // namespace
+
+namespace surface
+{
+
+template class Ring<float>;
+template class Ring<double>;
+
+template class Tube<float>;
+template class Tube<double>;
+
+template class Sweep<float>;
+template class Sweep<double>;
+
+} // namespace
+
+namespace intersection
+{
+
+template class CurveCurve<2, float>;
+template class CurveCurve<3, float>;
+template class CurveCurve<4, float>;
+template class CurveCurve<2, double>;
+template class CurveCurve<3, double>;
+template class CurveCurve<4, double>;
+
+} // namespace
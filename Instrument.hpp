@@ -0,0 +1,337 @@
+/** -*- C++ -*-
+ * @file Instrument.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef INSTRUMENT_HPP
+#define INSTRUMENT_HPP
+
+#include <ostream>
+#include <algorithm>
+
+/**
+ * Hot-path instrumentation.
+ *
+ * Compiled in with GEOM_INSTRUMENT (counters) and GEOM_INSTRUMENT_TIMERS
+ * (scoped timers, implies counters). When they are not defined, the probes
+ * GEOM_COUNT() and GEOM_SCOPE() expand to nothing.
+ *
+ * Each thread increments its own counters; snapshot() sums all threads.
+ * Without GEOM_INSTRUMENT, snapshot() always returns zeros.
+ */
+
+#if defined( GEOM_INSTRUMENT_TIMERS ) && !defined( GEOM_INSTRUMENT )
+#define GEOM_INSTRUMENT
+#endif
+
+#ifdef GEOM_INSTRUMENT
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace instrument
+{
+
+/**
+ * @brief Instrumented operations.
+ */
+enum Counter
+{
+	FindSpan,
+	BasisFuns,
+	DersBasisFuns,
+	CurvePoint,
+	CurveDerivs,
+	Derivative,
+	Simpson,
+	SimpsonRecursion,
+	Frenet,
+	Tube,
+	TubeRing,
+	Intersection,
+	Sampling,
+	NumCounters
+};
+
+/**
+ * @brief Returns the name of a counter.
+ */
+inline const char * name( Counter c )
+{
+	static const char * names[ NumCounters ] =
+	{
+		"findSpan",
+		"basisFuns",
+		"dersBasisFuns",
+		"curvePoint",
+		"curveDerivs",
+		"derivative",
+		"simpson",
+		"simpsonRecursion",
+		"frenet",
+		"tube",
+		"tubeRing",
+		"intersection",
+		"sampling"
+	};
+	return names[ c ];
+}
+
+/**
+ * @brief Values of the counters and timers at some point.
+ */
+struct Snapshot
+{
+	unsigned long long count[ NumCounters ]; /**< Number of calls. */
+	unsigned long long time[ NumCounters ];  /**< Time spent (ns), if timed. */
+
+	Snapshot()
+	{
+		std::fill( count, count + NumCounters, 0ULL );
+		std::fill( time, time + NumCounters, 0ULL );
+	}
+
+	Snapshot & operator+=( const Snapshot & s )
+	{
+		for ( int i = 0; i < NumCounters; i++ )
+		{
+			count[ i ] += s.count[ i ];
+			time[ i ] += s.time[ i ];
+		}
+		return *this;
+	}
+};
+
+/**
+ * @brief Writes a snapshot as JSON.
+ *
+ * {"findSpan": {"count": 12, "time_ns": 0}, ...}
+ */
+inline std::ostream & dump( std::ostream & os, const Snapshot & s )
+{
+	os << "{";
+	for ( int i = 0; i < NumCounters; i++ )
+	{
+		os << ( i ? ", " : "" ) << "\"" << name( (Counter)i ) << "\": {\"count\": "
+			<< s.count[ i ] << ", \"time_ns\": " << s.time[ i ] << "}";
+	}
+	os << "}";
+	return os;
+}
+
+#ifdef GEOM_INSTRUMENT
+
+/**
+ * @brief Counters of one thread.
+ *
+ * Only the owner thread writes, so increments are plain relaxed load/store
+ * (no locked instruction); other threads may read them at any time.
+ */
+class Counters
+{
+public:
+	Counters();
+	~Counters();
+
+	inline void add( Counter c, unsigned long long n, unsigned long long ns )
+	{
+		_count[ c ].store( _count[ c ].load( std::memory_order_relaxed ) + n, std::memory_order_relaxed );
+		_time[ c ].store( _time[ c ].load( std::memory_order_relaxed ) + ns, std::memory_order_relaxed );
+	}
+
+	Snapshot snapshot() const
+	{
+		Snapshot s;
+		for ( int i = 0; i < NumCounters; i++ )
+		{
+			s.count[ i ] = _count[ i ].load( std::memory_order_relaxed );
+			s.time[ i ] = _time[ i ].load( std::memory_order_relaxed );
+		}
+		return s;
+	}
+
+	void reset()
+	{
+		for ( int i = 0; i < NumCounters; i++ )
+		{
+			_count[ i ].store( 0, std::memory_order_relaxed );
+			_time[ i ].store( 0, std::memory_order_relaxed );
+		}
+	}
+
+private:
+	std::atomic<unsigned long long> _count[ NumCounters ];
+	std::atomic<unsigned long long> _time[ NumCounters ];
+};
+
+/**
+ * @brief Set of the counters of all threads.
+ */
+class Registry
+{
+public:
+	static Registry & instance()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	void attach( Counters * c )
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_threads.push_back( c );
+	}
+
+	/**
+	 * @brief Unregisters a thread and keeps its counts.
+	 */
+	void detach( Counters * c )
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_retired += c->snapshot();
+		_threads.erase( std::remove( _threads.begin(), _threads.end(), c ), _threads.end() );
+	}
+
+	Snapshot snapshot()
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		Snapshot s = _retired;
+		for ( std::size_t i = 0; i < _threads.size(); i++ )
+			s += _threads[ i ]->snapshot();
+		return s;
+	}
+
+	/**
+	 * @brief Resets all counters (should be called while no thread is measured).
+	 */
+	void reset()
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_retired = Snapshot();
+		for ( std::size_t i = 0; i < _threads.size(); i++ )
+			_threads[ i ]->reset();
+	}
+
+private:
+	std::mutex _mutex;
+	std::vector<Counters *> _threads;
+	Snapshot _retired;
+};
+
+inline Counters::Counters()
+{
+	reset();
+	Registry::instance().attach( this );
+}
+
+inline Counters::~Counters()
+{
+	Registry::instance().detach( this );
+}
+
+/**
+ * @brief Returns the counters of the calling thread.
+ */
+inline Counters & local()
+{
+	static thread_local Counters counters;
+	return counters;
+}
+
+/**
+ * @brief Counts one call.
+ */
+inline void count( Counter c )
+{
+	local().add( c, 1, 0 );
+}
+
+/**
+ * @brief Counts one call and measures its duration until destruction.
+ */
+class Timer
+{
+public:
+	Timer( Counter c ) : _counter( c ), _start( std::chrono::steady_clock::now() ) {}
+
+	~Timer()
+	{
+		std::chrono::nanoseconds ns = std::chrono::steady_clock::now() - _start;
+		local().add( _counter, 1, ns.count() );
+	}
+
+private:
+	Counter _counter;
+	std::chrono::steady_clock::time_point _start;
+};
+
+/**
+ * @brief Sums the counters of all threads.
+ */
+inline Snapshot snapshot()
+{
+	return Registry::instance().snapshot();
+}
+
+/**
+ * @brief Resets the counters of all threads.
+ */
+inline void reset()
+{
+	Registry::instance().reset();
+}
+
+#else
+
+inline Snapshot snapshot()
+{
+	return Snapshot();
+}
+
+inline void reset()
+{
+}
+
+#endif
+
+} // namespace
+
+// Probes
+
+#ifdef GEOM_INSTRUMENT
+#define GEOM_COUNT( c ) ::instrument::count( ::instrument::c )
+#else
+#define GEOM_COUNT( c ) ((void)0)
+#endif
+
+#ifdef GEOM_INSTRUMENT_TIMERS
+#define GEOM_SCOPE( c ) ::instrument::Timer geom_timer_##c( ::instrument::c )
+#else
+#define GEOM_SCOPE( c ) GEOM_COUNT( c )
+#endif
+
+#endif
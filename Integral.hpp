@@ -32,11 +32,34 @@ namespace integral
 
 /**
  * @brief Integral base class.
+ *
+ * Real is the type of the bounds and of the value; Compute is the type the
+ * function values are accumulated in (see Simpson).
  */
-template <class Real>
+template <class Real, class Compute = Real>
 struct Integral
 {
 	typedef Real Type;
+	typedef Compute ComputeType;
+};
+
+/**
+ * @brief Statistics of a computed integral.
+ *
+ * Filled by the result-reporting overload of the integral classes:
+ * integral( f, a, b, result ).
+ */
+template <class Real>
+struct Result
+{
+	Real value;      /**< Value of the integral. */
+	Real error;      /**< Estimated absolute error. */
+	int evaluations; /**< Number of evaluations of the function. */
+	int depth;       /**< Deepest recursion level reached (1 = [a, b] split once). */
+	bool converged;  /**< False if the accuracy was not reached everywhere. */
+
+	Result() :
+		value( 0 ), error( 0 ), evaluations( 0 ), depth( 0 ), converged( true ) {}
 };
 
 } // namespace
@@ -0,0 +1,922 @@
+/** -*- C++ -*-
+ * @file Intersection.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef INTERSECTION_HPP
+#define INTERSECTION_HPP
+
+#include "Vector.hpp"
+#include "Spline.hpp"
+#include "Parallel.hpp"
+#include "Instrument.hpp"
+#include <vector>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace intersection
+{
+
+/**
+ * @brief Axis-aligned bounding box.
+ */
+template <int N, class Real = float>
+class Box
+{
+public:
+	typedef geom::Vector<N, Real> Point;
+
+	/**
+	 * @brief Empty box constructor.
+	 */
+	Box() : _empty( true ) {}
+
+	/**
+	 * @brief Bounds a range of points.
+	 */
+	template <class Iterator>
+	Box( Iterator first, Iterator last ) : _empty( true )
+	{
+		for ( /* */; first != last; ++first )
+			extend( *first );
+	}
+
+	/**
+	 * @brief Grows the box to contain a point.
+	 */
+	void extend( const Point & p );
+
+	/**
+	 * @brief Grows the box to contain another box.
+	 */
+	void extend( const Box & box );
+
+	/**
+	 * @brief Tests whether two boxes are closer than a tolerance.
+	 */
+	bool overlaps( const Box & box, const Real & tolerance = 0 ) const;
+
+	/**
+	 * @brief Returns the largest extent.
+	 */
+	Real size() const;
+
+	bool isEmpty() const        { return _empty; }
+	const Point & low() const   { return _low; }
+	const Point & high() const  { return _high; }
+
+private:
+	Point _low, _high;
+	bool _empty;
+};
+
+/**
+ * @brief Bézier segment of a curve.
+ *
+ * Holds the control points of a polynomial or rational piece over its local
+ * parameter x in [0, 1], and the range [begin, end] it covers on the original
+ * curve. Control points are stored in cartesian coordinates, along with their
+ * weights for rational pieces; with positive weights the piece lies in the
+ * convex hull of these points, so boxes and flatness remain valid bounds.
+ */
+template <int N, class Real = float>
+class Bezier
+{
+public:
+	typedef geom::Vector<N, Real> Point;
+
+	Bezier() : _begin( 0 ), _end( 1 ) {}
+
+	/**
+	 * @param points The p+1 control points.
+	 * @param begin The curve parameter at x = 0.
+	 * @param end The curve parameter at x = 1.
+	 */
+	Bezier( std::vector<Point> && points, const Real & begin, const Real & end ) :
+		_points( std::move( points ) ), _begin( begin ), _end( end ),
+		_box( _points.begin(), _points.end() ) {}
+
+	/**
+	 * @param points The p+1 control points (cartesian coordinates).
+	 * @param weights Their p+1 positive weights.
+	 * @param begin The curve parameter at x = 0.
+	 * @param end The curve parameter at x = 1.
+	 */
+	Bezier( std::vector<Point> && points, std::vector<Real> && weights, const Real & begin, const Real & end ) :
+		_points( std::move( points ) ), _weights( std::move( weights ) ), _begin( begin ), _end( end ),
+		_box( _points.begin(), _points.end() ) {}
+
+	int getDegree() const                        { return (int)_points.size() - 1; }
+	bool isRational() const                      { return !_weights.empty(); }
+	const std::vector<Point>& controlPoints() const { return _points; }
+	const std::vector<Real>& weights() const     { return _weights; }
+	const Box<N, Real>& box() const              { return _box; }
+	Real begin() const                           { return _begin; }
+	Real end() const                             { return _end; }
+
+	/**
+	 * @brief Maps a local parameter to the curve parameter.
+	 */
+	Real parameter( const Real & x ) const { return _begin + ( _end - _begin ) * x; }
+
+	/**
+	 * @brief Computes B(x) (de Casteljau, in homogeneous coordinates if rational).
+	 */
+	Point operator()( const Real & x ) const;
+
+	/**
+	 * @brief Computes dB/dx (de Casteljau on the hodograph, quotient rule if rational).
+	 */
+	Point derivative( const Real & x ) const;
+
+	/**
+	 * @brief Splits the segment at x (de Casteljau, in homogeneous coordinates if rational).
+	 */
+	void split( const Real & x, Bezier & left, Bezier & right ) const;
+
+	/**
+	 * @brief Returns the largest distance of the control points to the chord.
+	 *
+	 * The segment lies within this distance of its chord (convex hull).
+	 */
+	Real flatness() const;
+
+private:
+	std::vector<Point> _points;
+	std::vector<Real> _weights;
+	Real _begin, _end;
+	Box<N, Real> _box;
+};
+
+/**
+ * @brief Splits a spline into its Bézier segments.
+ *
+ * Each non-empty knot span of the valid parameter range [u_p, u_{n+1}]
+ * gives one segment, whose control points are the blossom values
+ * (de Boor's algorithm with the span ends as parameters). This works for
+ * clamped and unclamped knot vectors alike. Rational curves are decomposed
+ * in homogeneous coordinates into rational segments; curves whose weights
+ * are all 1 give polynomial segments.
+ *
+ * @note Weights must be positive, so that segments lie in the convex hull
+ * of their control points.
+ */
+template <int N, class Real>
+std::vector<Bezier<N, Real> > decompose( const curve::Spline<N, Real> & curve );
+
+/**
+ * @brief An intersection point between two curves.
+ */
+template <int N, class Real = float>
+struct Hit
+{
+	typedef geom::Vector<N, Real> Point;
+
+	std::size_t first;  /**< Index of the first curve (batch mode, else 0). */
+	std::size_t second; /**< Index of the second curve (batch mode, else 1). */
+	Real s;             /**< Parameter on the first curve. */
+	Real t;             /**< Parameter on the second curve. */
+	Real distance;      /**< Distance between both curve points after polishing. */
+	Point point;        /**< Point on the first curve. */
+
+	Hit() : first( 0 ), second( 1 ), s( 0 ), t( 0 ), distance( 0 ) {}
+};
+
+/**
+ * @brief Curve-curve intersection.
+ *
+ * Curves are split into Bézier segments. Pairs of segments whose boxes
+ * overlap are subdivided until both are flat, then the closest points of
+ * their chords seed a Newton iteration on the distance between the two
+ * segments. A broad phase (sort and sweep on boxes) prunes the pairs,
+ * at the segment level and, in batch mode, at the curve level. The batch
+ * mode distributes curve pairs across threads.
+ *
+ * Intersections closer than a few tolerances are reported once. Overlapping
+ * (coincident) pieces of curves are reported as many points, up to
+ * maxDepth subdivisions.
+ */
+template <int N, class Real = float>
+class CurveCurve
+{
+public:
+	typedef geom::Vector<N, Real> Point;
+	typedef Bezier<N, Real> Segment;
+	typedef std::vector<Segment> Segments;
+	typedef Box<N, Real> BoxType;
+	typedef Hit<N, Real> HitType;
+	typedef std::vector<std::pair<std::size_t, std::size_t> > Pairs;
+
+	/**
+	 * @param tolerance Largest distance between two points considered equal.
+	 * @param flatness Largest flatness of a leaf, relative to its chord length.
+	 * @param maxDepth Maximum number of subdivisions.
+	 * @param iterations Maximum number of Newton iterations.
+	 */
+	CurveCurve( Real tolerance = 1e-5, Real flatness = 1e-2, int maxDepth = 40, int iterations = 8 ) :
+		_tolerance( tolerance ), _flatness( flatness ), _maxDepth( maxDepth ), _iterations( iterations ) {}
+
+	/**
+	 * @brief Intersects two curves.
+	 * @param hits Receives the intersections (appended), sorted by s.
+	 */
+	void operator()( const curve::Spline<N, Real> & a, const curve::Spline<N, Real> & b, std::vector<HitType> & hits ) const;
+
+	/**
+	 * @brief Intersects two decomposed curves (see decompose).
+	 * @param hits Receives the intersections (appended), sorted by s.
+	 */
+	void operator()( const Segments & a, const Segments & b, std::vector<HitType> & hits ) const;
+
+	/**
+	 * @brief Intersects every pair of curves of a set.
+	 * @param curves The curves (Spline or derived classes).
+	 * @param hits Receives the intersections (appended), sorted by curve indices then s.
+	 * @param threads Number of threads (0 = hardware threads).
+	 */
+	template <class CurveType>
+	void operator()( const std::vector<CurveType> & curves, std::vector<HitType> & hits, unsigned threads = 0 ) const;
+
+	/**
+	 * @brief Broad phase: finds the pairs of boxes closer than a tolerance.
+	 * @return Pairs ( i, j ) with i < j.
+	 */
+	static Pairs candidates( const std::vector<BoxType> & boxes, const Real & tolerance );
+
+	Real getTolerance() const               { return _tolerance; }
+	void setTolerance( const Real & t )     { _tolerance = t; }
+	Real getFlatness() const                { return _flatness; }
+	void setFlatness( const Real & f )      { _flatness = f; }
+	int getMaxDepth() const                 { return _maxDepth; }
+	void setMaxDepth( int max )             { _maxDepth = max; }
+	int getIterations() const               { return _iterations; }
+	void setIterations( int iterations )    { _iterations = iterations; }
+
+protected:
+	Real _tolerance;
+	Real _flatness;
+	int _maxDepth;
+	int _iterations;
+
+	/**
+	 * @brief Recursive subdivision of a pair of pieces of root segments.
+	 */
+	void subdivide( const Segment & a, const Segment & b, const Segment & rootA, const Segment & rootB, int depth, std::vector<HitType> & hits ) const;
+
+	/**
+	 * @brief Newton iteration on |A(x) - B(y)|^2, x and y kept in [0, 1].
+	 * @return The final distance.
+	 */
+	Real polish( const Segment & a, const Segment & b, Real & x, Real & y ) const;
+
+	/**
+	 * @brief Closest points of segments [p0, p1] and [q0, q1].
+	 * @return The distance between them.
+	 */
+	static Real closest( const Point & p0, const Point & p1, const Point & q0, const Point & q1, Real & x, Real & y );
+
+	/**
+	 * @brief Merges the hits closer than a few tolerances, keeping the best.
+	 */
+	void merge( std::vector<HitType> & hits ) const;
+};
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+void Box<N, Real>::extend( const Point & p )
+{
+	int i;
+
+	if ( _empty )
+	{
+		_low = _high = p;
+		_empty = false;
+		return;
+	}
+	for ( i = 0; i < N; i++ )
+	{
+		_low[ i ] = std::min( _low[ i ], p[ i ] );
+		_high[ i ] = std::max( _high[ i ], p[ i ] );
+	}
+}
+
+template <int N, class Real>
+void Box<N, Real>::extend( const Box & box )
+{
+	if ( box._empty )
+		return;
+	extend( box._low );
+	extend( box._high );
+}
+
+template <int N, class Real>
+bool Box<N, Real>::overlaps( const Box & box, const Real & tolerance ) const
+{
+	int i;
+
+	if ( _empty || box._empty )
+		return false;
+	for ( i = 0; i < N; i++ )
+	{
+		if ( _low[ i ] > box._high[ i ] + tolerance || box._low[ i ] > _high[ i ] + tolerance )
+			return false;
+	}
+	return true;
+}
+
+template <int N, class Real>
+Real Box<N, Real>::size() const
+{
+	Real s = 0;
+	int i;
+
+	if ( _empty )
+		return 0;
+	for ( i = 0; i < N; i++ )
+		s = std::max( s, _high[ i ] - _low[ i ] );
+	return s;
+}
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+typename Bezier<N, Real>::Point Bezier<N, Real>::operator()( const Real & x ) const
+{
+	Point Q[ _points.size() ];
+	Real W[ _points.size() ];
+	int p, j, k;
+
+	p = getDegree();
+	if ( isRational() )
+	{
+		for ( j = 0; j <= p; j++ )
+		{
+			Q[ j ] = _points[ j ] * _weights[ j ];
+			W[ j ] = _weights[ j ];
+		}
+		for ( k = 1; k <= p; k++ )
+		{
+			for ( j = 0; j <= p - k; j++ )
+			{
+				Q[ j ] = Q[ j ] * ( 1 - x ) + Q[ j+1 ] * x;
+				W[ j ] = W[ j ] * ( 1 - x ) + W[ j+1 ] * x;
+			}
+		}
+		return Q[ 0 ] / W[ 0 ];
+	}
+
+	for ( j = 0; j <= p; j++ )
+		Q[ j ] = _points[ j ];
+	for ( k = 1; k <= p; k++ )
+	{
+		for ( j = 0; j <= p - k; j++ )
+			Q[ j ] = Q[ j ] * ( 1 - x ) + Q[ j+1 ] * x;
+	}
+	return Q[ 0 ];
+}
+
+template <int N, class Real>
+typename Bezier<N, Real>::Point Bezier<N, Real>::derivative( const Real & x ) const
+{
+	Point Q[ _points.size() ];
+	Real W[ _points.size() ];
+	Point A, dA;
+	Real w, dw;
+	int p, j, k;
+
+	p = getDegree();
+	if ( p < 1 )
+		return Point();
+	if ( isRational() )
+	{
+		// Homogeneous A( x ) and w( x ) with their derivatives from the
+		// last two de Casteljau points, then C' = ( A' - w' C ) / w
+		for ( j = 0; j <= p; j++ )
+		{
+			Q[ j ] = _points[ j ] * _weights[ j ];
+			W[ j ] = _weights[ j ];
+		}
+		for ( k = 1; k < p; k++ )
+		{
+			for ( j = 0; j <= p - k; j++ )
+			{
+				Q[ j ] = Q[ j ] * ( 1 - x ) + Q[ j+1 ] * x;
+				W[ j ] = W[ j ] * ( 1 - x ) + W[ j+1 ] * x;
+			}
+		}
+		A = Q[ 0 ] * ( 1 - x ) + Q[ 1 ] * x;
+		w = W[ 0 ] * ( 1 - x ) + W[ 1 ] * x;
+		dA = ( Q[ 1 ] - Q[ 0 ] ) * (Real)p;
+		dw = ( W[ 1 ] - W[ 0 ] ) * p;
+		return ( dA - A * ( dw / w ) ) / w;
+	}
+
+	for ( j = 0; j < p; j++ )
+		Q[ j ] = ( _points[ j+1 ] - _points[ j ] ) * (Real)p;
+	for ( k = 1; k < p; k++ )
+	{
+		for ( j = 0; j < p - k; j++ )
+			Q[ j ] = Q[ j ] * ( 1 - x ) + Q[ j+1 ] * x;
+	}
+	return Q[ 0 ];
+}
+
+template <int N, class Real>
+void Bezier<N, Real>::split( const Real & x, Bezier & left, Bezier & right ) const
+{
+	std::vector<Point> Q( _points ), L, R;
+	std::vector<Real> W( _weights ), LW, RW;
+	Real middle;
+	int p, j, k;
+
+	p = getDegree();
+	middle = parameter( x );
+	L.resize( p+1 );
+	R.resize( p+1 );
+	if ( isRational() )
+	{
+		// Homogeneous coordinates, projected back at the end
+		LW.resize( p+1 );
+		RW.resize( p+1 );
+		for ( j = 0; j <= p; j++ )
+			Q[ j ] *= W[ j ];
+		L[ 0 ] = Q[ 0 ];
+		LW[ 0 ] = W[ 0 ];
+		R[ p ] = Q[ p ];
+		RW[ p ] = W[ p ];
+		for ( k = 1; k <= p; k++ )
+		{
+			for ( j = 0; j <= p - k; j++ )
+			{
+				Q[ j ] = Q[ j ] * ( 1 - x ) + Q[ j+1 ] * x;
+				W[ j ] = W[ j ] * ( 1 - x ) + W[ j+1 ] * x;
+			}
+			L[ k ] = Q[ 0 ];
+			LW[ k ] = W[ 0 ];
+			R[ p-k ] = Q[ p-k ];
+			RW[ p-k ] = W[ p-k ];
+		}
+		for ( j = 0; j <= p; j++ )
+		{
+			L[ j ] /= LW[ j ];
+			R[ j ] /= RW[ j ];
+		}
+		left = Bezier( std::move( L ), std::move( LW ), _begin, middle );
+		right = Bezier( std::move( R ), std::move( RW ), middle, _end );
+		return;
+	}
+
+	L[ 0 ] = Q[ 0 ];
+	R[ p ] = Q[ p ];
+	for ( k = 1; k <= p; k++ )
+	{
+		for ( j = 0; j <= p - k; j++ )
+			Q[ j ] = Q[ j ] * ( 1 - x ) + Q[ j+1 ] * x;
+		L[ k ] = Q[ 0 ];
+		R[ p-k ] = Q[ p-k ];
+	}
+	left = Bezier( std::move( L ), _begin, middle );
+	right = Bezier( std::move( R ), middle, _end );
+}
+
+template <int N, class Real>
+Real Bezier<N, Real>::flatness() const
+{
+	Point chord, v;
+	Real len2, d2, x;
+	int j, p;
+
+	p = getDegree();
+	chord = _points[ p ] - _points[ 0 ];
+	len2 = chord * chord;
+	d2 = 0;
+	for ( j = 1; j < p; j++ )
+	{
+		v = _points[ j ] - _points[ 0 ];
+		if ( len2 > 0 )
+		{
+			x = std::max( (Real)0, std::min( (Real)1, ( v * chord ) / len2 ) );
+			v -= chord * x;
+		}
+		d2 = std::max( d2, v * v );
+	}
+	return std::sqrt( d2 );
+}
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+std::vector<Bezier<N, Real> > decompose( const curve::Spline<N, Real> & curve )
+{
+	typedef geom::Vector<N, Real> Point;
+	const std::vector<Real> & U = curve.knotVector();
+	const std::vector<geom::WeightedPoint<N, Real> > & P = curve.controlPoints();
+	std::vector<Bezier<N, Real> > segments;
+	std::vector<Point> d;
+	std::vector<Real> dw;
+	Real a, b, x, alpha;
+	bool rational;
+	int i, j, k, r, n, p, m;
+
+	p = curve.getDegree();
+	n = (int)P.size() - 1;
+	m = (int)U.size() - 1;
+	if ( p < 1 || n < p || m != n + p + 1 )
+		return segments;
+
+	rational = false;
+	for ( i = 0; i <= n; i++ )
+	{
+		assert( P[ i ].weight() > 0 );
+		rational = rational || P[ i ].weight() != 1;
+	}
+
+	d.resize( p+1 );
+	dw.resize( p+1, 1 );
+	for ( i = p; i <= n; i++ )
+	{
+		a = U[ i ];
+		b = U[ i+1 ];
+		if ( !( a < b ) )
+			continue;
+
+		std::vector<Point> Q( p+1 );
+		std::vector<Real> W( rational ? p+1 : 0 );
+		for ( k = 0; k <= p; k++ )
+		{
+			// Blossom f( a, ..., a, b, ..., b ) with k times b, in
+			// homogeneous coordinates ( w P, w ) if rational
+			for ( j = 0; j <= p; j++ )
+			{
+				d[ j ] = P[ i-p+j ].point();
+				if ( rational )
+				{
+					dw[ j ] = P[ i-p+j ].weight();
+					d[ j ] *= dw[ j ];
+				}
+			}
+			for ( r = 1; r <= p; r++ )
+			{
+				x = ( r <= p - k ) ? a : b;
+				for ( j = p; j >= r; j-- )
+				{
+					alpha = ( x - U[ i-p+j ] ) / ( U[ i+1+j-r ] - U[ i-p+j ] );
+					d[ j ] = d[ j-1 ] * ( 1 - alpha ) + d[ j ] * alpha;
+					dw[ j ] = dw[ j-1 ] * ( 1 - alpha ) + dw[ j ] * alpha;
+				}
+			}
+			Q[ k ] = d[ p ];
+			if ( rational )
+			{
+				W[ k ] = dw[ p ];
+				Q[ k ] /= W[ k ];
+			}
+		}
+		if ( rational )
+			segments.push_back( Bezier<N, Real>( std::move( Q ), std::move( W ), a, b ) );
+		else
+			segments.push_back( Bezier<N, Real>( std::move( Q ), a, b ) );
+	}
+	return segments;
+}
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+void CurveCurve<N, Real>::operator()( const curve::Spline<N, Real> & a, const curve::Spline<N, Real> & b, std::vector<HitType> & hits ) const
+{
+	(*this)( decompose( a ), decompose( b ), hits );
+}
+
+template <int N, class Real>
+void CurveCurve<N, Real>::operator()( const Segments & a, const Segments & b, std::vector<HitType> & hits ) const
+{
+	std::vector<BoxType> boxes;
+	std::vector<HitType> found;
+	std::size_t i, na;
+
+	GEOM_SCOPE( Intersection );
+
+	na = a.size();
+	boxes.reserve( na + b.size() );
+	for ( i = 0; i < na; i++ )
+		boxes.push_back( a[ i ].box() );
+	for ( i = 0; i < b.size(); i++ )
+		boxes.push_back( b[ i ].box() );
+
+	// Segment pairs across both curves only
+	Pairs pairs = candidates( boxes, _tolerance );
+	for ( i = 0; i < pairs.size(); i++ )
+	{
+		if ( pairs[ i ].first < na && pairs[ i ].second >= na )
+		{
+			const Segment & sa = a[ pairs[ i ].first ];
+			const Segment & sb = b[ pairs[ i ].second - na ];
+			subdivide( sa, sb, sa, sb, 0, found );
+		}
+	}
+
+	merge( found );
+	std::sort( found.begin(), found.end(),
+		[]( const HitType & h1, const HitType & h2 ) { return h1.s < h2.s; } );
+	hits.insert( hits.end(), found.begin(), found.end() );
+}
+
+template <int N, class Real>
+template <class CurveType>
+void CurveCurve<N, Real>::operator()( const std::vector<CurveType> & curves, std::vector<HitType> & hits, unsigned threads ) const
+{
+	std::vector<Segments> segments( curves.size() );
+	std::vector<BoxType> boxes( curves.size() );
+	std::vector<std::vector<HitType> > found;
+	Pairs pairs;
+	std::size_t i, j;
+
+	// Decomposition, bounded by the control polygons
+	geom::parallelFor( curves.size(), threads, [ & ]( std::size_t c, unsigned )
+	{
+		segments[ c ] = decompose( static_cast<const curve::Spline<N, Real> &>( curves[ c ] ) );
+		for ( std::size_t k = 0; k < segments[ c ].size(); k++ )
+			boxes[ c ].extend( segments[ c ][ k ].box() );
+	} );
+
+	pairs = candidates( boxes, _tolerance );
+
+	found.resize( geom::threadCount( threads, pairs.size() ) );
+	geom::parallelFor( pairs.size(), threads, [ & ]( std::size_t k, unsigned worker )
+	{
+		std::vector<HitType> & out = found[ worker ];
+		std::size_t first = out.size();
+
+		(*this)( segments[ pairs[ k ].first ], segments[ pairs[ k ].second ], out );
+		for ( /* */; first < out.size(); first++ )
+		{
+			out[ first ].first = pairs[ k ].first;
+			out[ first ].second = pairs[ k ].second;
+		}
+	}, 1 );
+
+	// Deterministic order, whatever the scheduling
+	i = hits.size();
+	for ( j = 0; j < found.size(); j++ )
+		hits.insert( hits.end(), found[ j ].begin(), found[ j ].end() );
+	std::sort( hits.begin() + i, hits.end(), []( const HitType & h1, const HitType & h2 )
+	{
+		if ( h1.first != h2.first ) return h1.first < h2.first;
+		if ( h1.second != h2.second ) return h1.second < h2.second;
+		return h1.s < h2.s;
+	} );
+}
+
+template <int N, class Real>
+typename CurveCurve<N, Real>::Pairs CurveCurve<N, Real>::candidates( const std::vector<BoxType> & boxes, const Real & tolerance )
+{
+	std::vector<std::size_t> order, active;
+	Pairs pairs;
+	std::size_t i, j, k, a, b;
+
+	// Sort and sweep along the first axis
+	for ( i = 0; i < boxes.size(); i++ )
+	{
+		if ( !boxes[ i ].isEmpty() )
+			order.push_back( i );
+	}
+	std::sort( order.begin(), order.end(), [ & ]( std::size_t i1, std::size_t i2 )
+	{
+		return boxes[ i1 ].low()[ 0 ] < boxes[ i2 ].low()[ 0 ];
+	} );
+
+	for ( i = 0; i < order.size(); i++ )
+	{
+		b = order[ i ];
+		for ( j = k = 0; j < active.size(); j++ )
+		{
+			a = active[ j ];
+			if ( boxes[ a ].high()[ 0 ] + tolerance < boxes[ b ].low()[ 0 ] )
+				continue;
+			active[ k++ ] = a;
+			if ( boxes[ a ].overlaps( boxes[ b ], tolerance ) )
+				pairs.push_back( std::make_pair( std::min( a, b ), std::max( a, b ) ) );
+		}
+		active.resize( k );
+		active.push_back( b );
+	}
+
+	std::sort( pairs.begin(), pairs.end() );
+	return pairs;
+}
+
+template <int N, class Real>
+void CurveCurve<N, Real>::subdivide( const Segment & a, const Segment & b, const Segment & rootA, const Segment & rootB, int depth, std::vector<HitType> & hits ) const
+{
+	Segment left, right;
+	HitType hit;
+	Real fa, fb, x, y, d;
+	int pa, pb;
+
+	if ( !a.box().overlaps( b.box(), _tolerance ) )
+		return;
+
+	const std::vector<Point> & A = a.controlPoints();
+	const std::vector<Point> & B = b.controlPoints();
+	pa = a.getDegree();
+	pb = b.getDegree();
+	fa = a.flatness();
+	fb = b.flatness();
+
+	if ( depth >= _maxDepth ||
+		( fa <= _tolerance + _flatness * ( A[ pa ] - A[ 0 ] ).length() &&
+		  fb <= _tolerance + _flatness * ( B[ pb ] - B[ 0 ] ).length() ) )
+	{
+		// Each piece lies within its flatness of its chord
+		d = closest( A[ 0 ], A[ pa ], B[ 0 ], B[ pb ], x, y );
+		if ( d > _tolerance + fa + fb )
+			return;
+
+		// Seed in the local parameters of the root segments
+		x = ( a.parameter( x ) - rootA.begin() ) / ( rootA.end() - rootA.begin() );
+		y = ( b.parameter( y ) - rootB.begin() ) / ( rootB.end() - rootB.begin() );
+		hit.distance = polish( rootA, rootB, x, y );
+		if ( hit.distance > _tolerance )
+			return;
+
+		hit.s = rootA.parameter( x );
+		hit.t = rootB.parameter( y );
+		hit.point = rootA( x );
+		hits.push_back( hit );
+		return;
+	}
+
+	// Subdivide the larger piece
+	if ( a.box().size() >= b.box().size() )
+	{
+		a.split( 0.5, left, right );
+		subdivide( left, b, rootA, rootB, depth + 1, hits );
+		subdivide( right, b, rootA, rootB, depth + 1, hits );
+	}
+	else
+	{
+		b.split( 0.5, left, right );
+		subdivide( a, left, rootA, rootB, depth + 1, hits );
+		subdivide( a, right, rootA, rootB, depth + 1, hits );
+	}
+}
+
+template <int N, class Real>
+Real CurveCurve<N, Real>::polish( const Segment & a, const Segment & b, Real & x, Real & y ) const
+{
+	Point r, da, db;
+	Real aa, ab, bb, ga, gb, det, dx, dy;
+	int i;
+
+	r = a( x ) - b( y );
+	for ( i = 0; i < _iterations && r.length() > _tolerance * 1e-3; i++ )
+	{
+		// Gauss-Newton step on r( x, y ) = A( x ) - B( y )
+		da = a.derivative( x );
+		db = b.derivative( y );
+		aa = da * da;
+		ab = -( da * db );
+		bb = db * db;
+		ga = da * r;
+		gb = -( db * r );
+		det = aa * bb - ab * ab;
+		if ( !( std::fabs( det ) > 0 ) )
+			break;
+		dx = -( bb * ga - ab * gb ) / det;
+		dy = -( aa * gb - ab * ga ) / det;
+		x = std::max( (Real)0, std::min( (Real)1, x + dx ) );
+		y = std::max( (Real)0, std::min( (Real)1, y + dy ) );
+		r = a( x ) - b( y );
+		if ( std::fabs( dx ) + std::fabs( dy ) < std::numeric_limits<Real>::epsilon() )
+			break;
+	}
+	return r.length();
+}
+
+template <int N, class Real>
+Real CurveCurve<N, Real>::closest( const Point & p0, const Point & p1, const Point & q0, const Point & q1, Real & x, Real & y )
+{
+	Point d1, d2, r;
+	Real a, e, f, b, c, denom;
+
+	d1 = p1 - p0;
+	d2 = q1 - q0;
+	r = p0 - q0;
+	a = d1 * d1;
+	e = d2 * d2;
+	f = d2 * r;
+	x = y = 0;
+
+	if ( a <= 0 && e <= 0 )
+		return r.length();
+	if ( a <= 0 )
+	{
+		y = std::max( (Real)0, std::min( (Real)1, f / e ) );
+	}
+	else
+	{
+		c = d1 * r;
+		if ( e <= 0 )
+		{
+			x = std::max( (Real)0, std::min( (Real)1, -c / a ) );
+		}
+		else
+		{
+			b = d1 * d2;
+			denom = a * e - b * b;
+			if ( denom > 0 )
+				x = std::max( (Real)0, std::min( (Real)1, ( b * f - c * e ) / denom ) );
+			y = ( b * x + f ) / e;
+			if ( y < 0 )
+			{
+				y = 0;
+				x = std::max( (Real)0, std::min( (Real)1, -c / a ) );
+			}
+			else if ( y > 1 )
+			{
+				y = 1;
+				x = std::max( (Real)0, std::min( (Real)1, ( b - c ) / a ) );
+			}
+		}
+	}
+	return ( p0 + d1 * x - q0 - d2 * y ).length();
+}
+
+template <int N, class Real>
+void CurveCurve<N, Real>::merge( std::vector<HitType> & hits ) const
+{
+	std::vector<HitType> kept;
+	std::size_t i, j;
+	Real radius = 10 * _tolerance;
+	bool found;
+
+	// Sweep along the first axis
+	std::sort( hits.begin(), hits.end(),
+		[]( const HitType & h1, const HitType & h2 ) { return h1.point[ 0 ] < h2.point[ 0 ]; } );
+
+	kept.reserve( hits.size() );
+	for ( i = 0; i < hits.size(); i++ )
+	{
+		found = false;
+		for ( j = kept.size(); j-- > 0 && kept[ j ].point[ 0 ] >= hits[ i ].point[ 0 ] - radius; /* */ )
+		{
+			if ( ( kept[ j ].point - hits[ i ].point ).length() <= radius )
+			{
+				if ( hits[ i ].distance < kept[ j ].distance )
+					kept[ j ] = hits[ i ];
+				found = true;
+				break;
+			}
+		}
+		if ( !found )
+			kept.push_back( hits[ i ] );
+	}
+	hits.swap( kept );
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace intersection
+{
+
+extern template class CurveCurve<2, float>;
+extern template class CurveCurve<3, float>;
+extern template class CurveCurve<4, float>;
+extern template class CurveCurve<2, double>;
+extern template class CurveCurve<3, double>;
+extern template class CurveCurve<4, double>;
+
+} // namespace
+#endif
+
+#endif
@@ -45,32 +45,23 @@ public:
 	/**
 	 * @brief Null matrix constructor.
 	 */
-	Matrix()
+	constexpr Matrix() :
+		_m()
 	{
-		for ( int i = 0; i < M; i++ )
-		{
-			for ( int j = 0; j < N; j++ )
-				_m[ i ][ j ] = 0;
-		}
 	}
 
 	/**
-	 * @brief Copy constructor.
+	 * @brief Copy constructor and assignment.
 	 */
-	Matrix( const Matrix & matrix )
-	{
-		for ( int i = 0; i < M; i++ )
-		{
-			for ( int j = 0; j < N; j++ )
-				_m[ i ][ j ] = matrix._m[ i ][ j ];
-		}
-	}
+	constexpr Matrix( const Matrix & matrix ) = default;
+	constexpr Matrix & operator=( const Matrix & matrix ) = default;
 
 	/**
 	 * @brief Constructor from a C-array of Real.
 	 * @param mat A C-array of Real (M*N elements).
 	 */
-	Matrix( const Real * mat )
+	constexpr Matrix( const Real * mat ) :
+		_m()
 	{
 		for ( int i = 0; i < M; i++ )
 		{
@@ -84,7 +75,7 @@ public:
 	 * @param i 0 is a0x, 1 is a1x, 2 is a2x, ...
 	 * @return The i-th row.
 	 */
-	inline const Real * operator[]( int i ) const
+	constexpr const Real * operator[]( int i ) const
 	{
 		return _m[ i ];
 	}
@@ -94,7 +85,7 @@ public:
 	 * @param i 0 is x, 1 is y, 2 is z, ...
 	 * @return The i-th row.
 	 */
-	inline Real * operator[]( int i )
+	constexpr Real * operator[]( int i )
 	{
 		return _m[ i ];
 	}
@@ -105,7 +96,7 @@ public:
 	 * @param j
 	 * @return aij element.
 	 */
-	inline const Real& operator()( int i, int j ) const
+	constexpr const Real& operator()( int i, int j ) const
 	{
 		return _m[ i ][ j ];
 	}
@@ -116,7 +107,7 @@ public:
 	 * @param j
 	 * @return aij element.
 	 */
-	inline Real& operator()( int i, int j )
+	constexpr Real& operator()( int i, int j )
 	{
 		return _m[ i ][ j ];
 	}
@@ -126,7 +117,7 @@ public:
 	 * @param i
 	 * @return The i-th row.
 	 */
-	Vector<N, Real> row( int i ) const
+	constexpr Vector<N, Real> row( int i ) const
 	{
 		return Vector<N, Real>( _m[ i ] );
 	}
@@ -136,7 +127,7 @@ public:
 	 * @param j
 	 * @return The j-th column.
 	 */
-	Vector<M, Real> column( int j ) const
+	constexpr Vector<M, Real> column( int j ) const
 	{
 		Vector<M, Real> vect;
 		for ( int i = 0; i < M; i++ )
@@ -147,7 +138,7 @@ public:
 	/**
 	 * @brief Replace a row.
 	 */
-	void setRow( int i, const geom::Vector<N, Real> & v )
+	constexpr void setRow( int i, const geom::Vector<N, Real> & v )
 	{
 		for ( int j = 0; j < N; j++ )
 			_m[ i ][ j ] = v[ j ];
@@ -156,7 +147,7 @@ public:
 	/**
 	 * @brief Replace every row.
 	 */
-	void setRows( const geom::Vector<N, Real> * v )
+	constexpr void setRows( const geom::Vector<N, Real> * v )
 	{
 		for ( int i = 0; i < M; i++ )
 		{
@@ -167,7 +158,7 @@ public:
 	/**
 	 * @brief Replace a column.
 	 */
-	void setColumn( int j, const geom::Vector<N, Real> & v )
+	constexpr void setColumn( int j, const geom::Vector<M, Real> & v )
 	{
 		for ( int i = 0; i < M; i++ )
 			_m[ i ][ j ] = v[ i ];
@@ -176,7 +167,7 @@ public:
 	/**
 	 * @brief Replace every column.
 	 */
-	void setColumns( const geom::Vector<N, Real> * v )
+	constexpr void setColumns( const geom::Vector<M, Real> * v )
 	{
 		for ( int j = 0; j < N; j++ )
 			setColumn( j, v[ j ] );
@@ -193,7 +184,7 @@ public:
 	/**
 	 * @brief Equal to operator.
 	 */
-	bool operator==( const Matrix & matrix ) const
+	constexpr bool operator==( const Matrix & matrix ) const
 	{
 		bool res = true;
 
@@ -208,7 +199,7 @@ public:
 	/**
 	 * @brief Not equal to operator.
 	 */
-	bool operator!=( const Matrix & matrix ) const
+	constexpr bool operator!=( const Matrix & matrix ) const
 	{
 		bool res = false;
 
@@ -223,7 +214,7 @@ public:
 	/**
 	 * @brief Addition operator.
 	 */
-	const Matrix operator+( const Matrix & matrix ) const
+	constexpr const Matrix operator+( const Matrix & matrix ) const
 	{
 		Matrix res;
 
@@ -238,7 +229,7 @@ public:
 	/**
 	 * @brief Addition assignment operator.
 	 */
-	Matrix & operator+=( const Matrix & matrix )
+	constexpr Matrix & operator+=( const Matrix & matrix )
 	{
 		for ( int i = 0; i < M; i++ )
 		{
@@ -251,7 +242,7 @@ public:
 	/**
 	 * @brief Subtraction operator.
 	 */
-	const Matrix operator-( const Matrix & matrix ) const
+	constexpr const Matrix operator-( const Matrix & matrix ) const
 	{
 		Matrix res;
 
@@ -266,7 +257,7 @@ public:
 	/**
 	 * @brief Subtraction assignment operator.
 	 */
-	Matrix & operator-=( const Matrix & matrix )
+	constexpr Matrix & operator-=( const Matrix & matrix )
 	{
 		for ( int i = 0; i < M; i++ )
 		{
@@ -279,7 +270,7 @@ public:
 	/**
 	 * @brief Minus operator.
 	 */
-	const Matrix operator-() const
+	constexpr const Matrix operator-() const
 	{
 		Matrix res;
 
@@ -292,18 +283,18 @@ public:
 	}
 
 	/**
-	 * @brief Dot product.
+	 * @brief Matrix product (M x N by N x P).
 	 */
-	const Matrix operator*( const Matrix & matrix ) const
+	template <int P>
+	constexpr const Matrix<M, P, Real> operator*( const Matrix<N, P, Real> & matrix ) const
 	{
-		Matrix res;
+		Matrix<M, P, Real> res;
 
 		for ( int i = 0; i < M; i++ )
 		{
-			for ( int j = 0; j < N; j++ )
+			for ( int k = 0; k < N; k++ )
 			{
-				res[ i ][ j ] = 0;
-				for ( int k = 0; k < N; k++ )
+				for ( int j = 0; j < P; j++ )
 					res[ i ][ j ] += _m[ i ][ k ] * matrix[ k ][ j ];
 			}
 		}
@@ -313,7 +304,7 @@ public:
 	/**
 	 * @brief Multiplication with a scalar.
 	 */
-	const Matrix operator*( const Real & r ) const
+	constexpr const Matrix operator*( const Real & r ) const
 	{
 		Matrix res;
 
@@ -328,7 +319,7 @@ public:
 	/**
 	 * @brief Multiplication assignment with a scalar.
 	 */
-	Matrix & operator*=( const Real & r )
+	constexpr Matrix & operator*=( const Real & r )
 	{
 		for ( int i = 0; i < M; i++ )
 		{
@@ -341,7 +332,7 @@ public:
 	/**
 	 * @brief Division with a scalar.
 	 */
-	const Matrix operator/( const Real & r ) const
+	constexpr const Matrix operator/( const Real & r ) const
 	{
 		Matrix res;
 
@@ -356,7 +347,7 @@ public:
 	/**
 	 * @brief Division assignment with a scalar.
 	 */
-	Matrix & operator/=( const Real & r )
+	constexpr Matrix & operator/=( const Real & r )
 	{
 		for ( int i = 0; i < M; i++ )
 		{
@@ -387,7 +378,7 @@ private:
 */
 
 template <int M, int N, class Real>
-const geom::Vector<M, Real> operator*( const geom::Matrix<M, N, Real>& matrix, const geom::Vector<N, Real>& vect )
+constexpr const geom::Vector<M, Real> operator*( const geom::Matrix<M, N, Real>& matrix, const geom::Vector<N, Real>& vect )
 {
 	geom::Vector<M, Real> res;
 	for ( int i = 0; i < M; i++ )
@@ -405,7 +396,7 @@ const geom::Vector<M, Real> operator*( const geom::Matrix<M, N, Real>& matrix, c
 */
 
 template <int M, int N, class Real>
-const geom::Vector<N, Real> operator*( const geom::Vector<M, Real>& vect, const geom::Matrix<M, N, Real>& matrix )
+constexpr const geom::Vector<N, Real> operator*( const geom::Vector<M, Real>& vect, const geom::Matrix<M, N, Real>& matrix )
 {
 	geom::Vector<N, Real> res;
 	for ( int j = 0; j < N; j++ )
@@ -449,29 +440,21 @@ std::ostream & operator<<( std::ostream & os, const geom::Matrix<M, N, Real> & m
 	return os;
 }
 
-// OpenSceneGraph
-
-#include <osg/Uniform>
+// Explicit instantiations (see Instances.cpp)
 
-/**
- * @brief Converts a geom::Matrix<2, 2> into a osg::Matrix2.
- */
-template<class Real>
-const geom::Matrix<2, 2, Real> & operator>>( const geom::Matrix<2, 2, Real> & u, osg::Matrix2 & v )
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace geom
 {
-	v.set( (const Real *)u.ptr() );
-	return u;
-}
 
-/**
- * @brief Converts a geom::Matrix<3, 3> into a osg::Matrix3.
- */
-template<int M, int N, class Real>
-const geom::Matrix<3, 3, Real> & operator>>( const geom::Matrix<3, 3, Real> & u, osg::Matrix3 & v )
-{
-	v.set( (const Real *)u.ptr() );
-	return u;
-}
+extern template class Matrix<2, 2, float>;
+extern template class Matrix<3, 3, float>;
+extern template class Matrix<4, 4, float>;
+extern template class Matrix<2, 2, double>;
+extern template class Matrix<3, 3, double>;
+extern template class Matrix<4, 4, double>;
+
+} // namespace
+#endif
 
 #endif
 
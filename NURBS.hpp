@@ -28,21 +28,51 @@
 #define CURVE_NURBS_HPP
 
 #include "Spline.hpp"
+#include "Basis.hpp"
+#include "Instrument.hpp"
+#include "Dispatch.hpp"
 
 namespace curve
 {
 
 /**
- * @brief NURBS curve base class.
+ * @brief NURBS curve class.
  *
- * A class template for NURBS curves.
+ * A class template for NURBS curves. Points and knots are stored as Real;
+ * basis functions and sums are computed as Compute (e.g. float storage
+ * with double evaluation). Final, so that curve::Static evaluates it
+ * without virtual calls.
  */
-template <int N, class Real = float>
-class NURBS : public Spline<N, Real>
+template <int N, class Real = float, class Compute = Real>
+class NURBS final : public Spline<N, Real>
 {
 public:
 	typedef Spline<N, Real> Parent;
 	typedef geom::Vector<N, Real> Point;
+	typedef geom::WeightedPoint<N, Real> ControlPoint;
+	typedef Compute ComputeType;
+
+	// Same constructors as Spline.
+	using Spline<N, Real>::Spline;
+
+	// Arc length with a given integral.
+	using Parent::length;
+
+	/**
+	 * @brief Computes the arc length between a and b with Simpson integration in Compute.
+	 */
+	Real length( const Real& a, const Real& b ) const
+	{
+		return Parent::length( a, b, integral::Simpson<Real, Compute>() );
+	}
+
+	/**
+	 * @brief Computes the total arc length with Simpson integration in Compute.
+	 */
+	Real length() const
+	{
+		return Parent::length( integral::Simpson<Real, Compute>() );
+	}
 
 	/**
 	 * @brief Computes C(t).
@@ -59,288 +89,274 @@ public:
 	 */
 	virtual inline Point derivative( const Real& t, int k = 1 ) const;
 
-protected:
-	// Please see below.
-	class Matrix;
-
 	/**
-	 * @see Algorithm A2.1, page 68, The NURBS Book (Springer 1997).
+	 * @brief Computes C(k) at count parameters.
+	 *
+	 * Basis functions are computed several parameters at a time
+	 * (see basis::basisFunsLanes), with the kernel of the active
+	 * instruction set (see geom::cpu::isa).
+	 * @param t The parameters, array of size count.
+	 * @param out Output array of size count.
+	 * @param count Number of parameters.
+	 * @param k The order k (0 for points).
 	 */
-	int findSpan( int n, int p, Real u, const std::vector<Real> & U ) const;
+	void evaluate( const Real * t, Point * out, std::size_t count, int k = 0 ) const;
 
+protected:
 	/**
-	 * @param N Array of size p+1
-	 * @see Algorithm A2.2, page 70, The NURBS Book (Springer 1997).
+	 * @brief evaluate() with Lanes parameters per basis computation.
 	 */
-	void basisFuns( int i, Real u, int p, const std::vector<Real> & U, Real * N_ ) const;
+	template <int Lanes>
+	void evaluateLanes( const Real * t, Point * out, std::size_t count, int k ) const;
 
-	/**
-	 * @see Algorithm A4.1, page 124, The NURBS Book (Springer 1997).
-	 */
-	void curvePoint( int n, int p, const std::vector<Real> & U, const std::vector<Point> & Pw, Real u, Point & C ) const;
+#ifdef GEOM_HAVE_DISPATCH
+	GEOM_TARGET( "avx2,fma" )
+	void evaluateAVX2( const Real * t, Point * out, std::size_t count, int k ) const
+	{
+		evaluateLanes<8>( t, out, count, k );
+	}
+
+	GEOM_TARGET( "avx512f,avx512vl,avx512bw,avx512dq" )
+	void evaluateAVX512( const Real * t, Point * out, std::size_t count, int k ) const
+	{
+		evaluateLanes<16>( t, out, count, k );
+	}
+#endif
 
 	/**
-	 * @param ders Two-dimensional array of size n+1 x p+1
-	 * @see Algorithm A2.3, page 72, The NURBS Book (Springer 1997).
+	 * @param span The knot span of u (see Spline::findSpan).
+	 * @see Algorithm A4.1, page 124, The NURBS Book (Springer 1997).
 	 */
-	void dersBasisFuns( int i, Real u, int p, int n, const std::vector<Real> & U, Matrix & ders ) const;
+	void curvePoint( int span, int p, const std::vector<Real> & U, const std::vector<ControlPoint> & Pw, Real u, Point & C ) const;
 
 	/**
+	 * @param span The knot span of u (see Spline::findSpan).
 	 * @param CK Array of size d+1
-	 * @see Algorithm A3.2, page 93, The NURBS Book (Springer 1997).
+	 * @see Algorithms A3.2 and A4.2, pages 93 and 127, The NURBS Book (Springer 1997).
 	 */
-	void curveDerivs( int n, int p, const std::vector<Real> & U, const std::vector<Point> & P, Real u, int d, Point * CK ) const;
+	void curveDerivs( int span, int p, const std::vector<Real> & U, const std::vector<ControlPoint> & P, Real u, int d, Point * CK ) const;
 
 	/**
 	 * @brief Keeps u value in the good interval.
 	 * @param u The value to correct.
 	 */
 	void adjustParameter( Real & u ) const;
-
-	/**
-	 * @brief A very small matrix class to pass Real[][] in function arguments.
-	 */
-	class Matrix
-	{
-	public:
-		Matrix( int m, int n ) : rows( m ), cols( n )
-		{
-			data = new Real[ m * n * sizeof( Real ) ];
-		}
-		~Matrix()
-		{
-			delete [] data;
-		}
-		Real * operator[] ( int i )
-		{
-			return &data[ rows * i ];
-		}
-		int rows, cols;
-		Real * data;
-	};
 };
 
 // -----------------------------------------------------------------------------
 
-template <int N, class Real>
-typename NURBS<N, Real>::Point NURBS<N, Real>::operator() ( const Real& t ) const
+template <int N, class Real, class Compute>
+typename NURBS<N, Real, Compute>::Point NURBS<N, Real, Compute>::operator() ( const Real& t ) const
 {
 	Point C;
 	Real u = t;
-	int n, p;
+	int p;
 
 	p = this->getDegree();
-	n = this->controlPoints().size() - 1;
 
 	adjustParameter( u );
-	curvePoint( n, p, Parent::_knotVector, Parent::_controlPoints, u, C );
+	curvePoint( this->findSpan( u ), p, Parent::_knotVector, Parent::_controlPoints, u, C );
 	return C;
 }
 
-template <int N, class Real>
-typename NURBS<N, Real>::Point NURBS<N, Real>::derivative( const Real& t, int d ) const
+template <int N, class Real, class Compute>
+typename NURBS<N, Real, Compute>::Point NURBS<N, Real, Compute>::derivative( const Real& t, int d ) const
 {
 	Point CK[ d+1 ];
 	Real u = t;
-	int n, p;
+	int p;
+
+	GEOM_COUNT( Derivative );
 
 	p = this->getDegree();
-	n = this->controlPoints().size() - 1;
 
 	adjustParameter( u );
-	curveDerivs( n, p, Parent::_knotVector, Parent::_controlPoints, u, d, CK );
+	curveDerivs( this->findSpan( u ), p, Parent::_knotVector, Parent::_controlPoints, u, d, CK );
 	return CK[ d ];
 }
 
-template <int N, class Real>
-int NURBS<N, Real>::findSpan( int n, int p, Real u, const std::vector<Real> & U ) const
+template <int N, class Real, class Compute>
+void NURBS<N, Real, Compute>::evaluate( const Real * t, Point * out, std::size_t count, int k ) const
 {
-	int low, high, mid;
-
-	// Special case
-	if ( u <= U.at( p ) ) return p;
-	if ( u >= U.at( n+1 ) ) return n;
-
-	// Do binary search
-	low = p;
-	high = n + 1;
-	mid = ( low + high ) / 2;
-	while ( u < U.at( mid ) || u >= U.at( mid + 1 ) )
+	switch ( geom::cpu::isa() )
 	{
-		if ( u < U.at( mid ) )
-			high = mid;
-		else
-			low = mid;
-		mid = ( low + high ) / 2;
+#ifdef GEOM_HAVE_DISPATCH
+	case geom::cpu::AVX512: evaluateAVX512( t, out, count, k ); break;
+	case geom::cpu::AVX2:   evaluateAVX2( t, out, count, k ); break;
+#endif
+	default:                evaluateLanes<8>( t, out, count, k ); break;
 	}
-	return mid;
 }
 
-template <int N, class Real>
-void NURBS<N, Real>::basisFuns( int i, Real u, int p, const std::vector<Real> & U, Real * N_ ) const
+template <int N, class Real, class Compute>
+template <int Lanes>
+void NURBS<N, Real, Compute>::evaluateLanes( const Real * t, Point * out, std::size_t count, int k ) const
 {
-	Real left[ p+1 ], right[ p+1 ];
-	Real saved, temp;
-	int j, r;
+	typedef geom::Vector<N, Compute> ComputePoint;
+	const std::vector<ControlPoint> & P = Parent::_controlPoints;
+	const std::vector<Real> & U = Parent::_knotVector;
+	std::size_t first, lanes, l;
+	int p, du, d, j, c, span[ Lanes ];
+	Real v;
 
-	N_[ 0 ] = 1.;
-	for ( j = 1; j <= p; j++ )
-	{
-		left [ j ] = u - U.at( i+1-j );
-		right[ j ] = U.at( i+j ) - u;
-		saved = 0.;
-		for ( r = 0; r < j; r++ )
-		{
-			temp = N_[ r ] / ( right[ r+1 ] + left[ j-r ] );
-			N_[ r ] = saved + right[ r+1 ] * temp;
-			saved = left[ j-r ] * temp;
-		}
-		N_[ j ] = saved;
-	}
-}
+	p = this->getDegree();
+	du = std::min( k, p );
 
-template <int N, class Real>
-void NURBS<N, Real>::curvePoint( int n, int p, const std::vector<Real> & U, const std::vector<Point> & Pw, Real u, Point & C ) const
-{
-	Real N_[ p+1 ];
-	Point Cw, Pi;
-	int span, j;
+	Compute u[ Lanes ], ders[ ( k+1 ) * ( p+1 ) * Lanes ], wders[ k+1 ], Nw;
+	ComputePoint Aders[ k+1 ];
 
-	span = findSpan( n, p, u, U );
-	basisFuns( span, u, p, U, N_ );
-	for ( j = 0; j <= p; j++ )
-	{
-		Pi = Pw[ span-p+j ];
-		Cw += Pi * Pi.weight() * N_[ j ];
-	}
-	// Divide by weight
-	C = Cw / Cw.weight();
-}
-
-template <int N, class Real>
-void NURBS<N, Real>::dersBasisFuns( int i, Real u, int p, int n, const std::vector<Real> & U, Matrix & ders ) const
-{
-	Real ndu[ p+1 ][ p+1 ], a[ 2 ][ p+1 ];
-	Real left[ p+1 ], right[ p+1 ];
-	Real saved, temp, d;
-	int j, k, r, rk, pk, j1, j2, s1, s2;
+	// Derivatives above the degree are zero
+	for ( j = ( du+1 ) * ( p+1 ) * Lanes; j < ( k+1 ) * ( p+1 ) * Lanes; j++ )
+		ders[ j ] = 0.;
 
-	ndu[ 0 ][ 0 ] = 1.;
-	for ( j = 1; j <= p; j++ )
+	for ( first = 0; first < count; first += Lanes )
 	{
-		left[ j ] = u - U.at( i+1-j );
-		right[ j ] = U.at( i+j ) - u;
-		saved = 0.;
-		for ( r = 0; r < j; r++ )
+		// Unused lanes repeat the last parameter
+		lanes = std::min( (std::size_t)Lanes, count - first );
+		for ( l = 0; l < Lanes; l++ )
 		{
-			// Lower triangle
-			ndu[ j ][ r ] = right[ r+1 ] + left[ j-r ];
-			temp = ndu[ r ][ j-1 ] / ndu[ j ][ r ];
-
-			// Upper triangle
-			ndu[ r ][ j ] = saved + right[ r+1 ] * temp;
-			saved = left[ j-r ] * temp;
+			v = t[ first + std::min( l, lanes - 1 ) ];
+			adjustParameter( v );
+			span[ l ] = l ? this->findSpan( v, span[ l-1 ] ) : this->findSpan( v );
+			u[ l ] = v;
 		}
-		ndu[ j ][ j ] = saved;
-	}
 
-	// Load the basis functions
-	for ( j = 0; j <= p; j++ )
-		ders[ 0 ][ j ] = ndu[ j ][ p ];
-
-	// This section computes the derivatives
-	for ( r = 0; r <= p; r++ )
-	{
-		// Alternate rows in array a
-		s1 = 0;
-		s2 = 1;
-		a[ 0 ][ 0 ] = 1.;
-		for ( k = 1; k <= n; k++ )
+		if ( k == 0 )
 		{
-			d = 0.;
-			rk = r - k;
-			pk = p - k;
-			if ( r >= k )
+			basis::basisFunsLanes<Lanes>( span, u, p, U.data(), ders );
+
+			// Homogeneous sums along the lanes
+			Compute Cw[ N+1 ][ Lanes ];
+			for ( c = 0; c <= N; c++ )
+				for ( l = 0; l < Lanes; l++ )
+					Cw[ c ][ l ] = 0.;
+			for ( j = 0; j <= p; j++ )
 			{
-				a[ s2 ][ 0 ] = a[ s1 ][ 0 ] / ndu[ pk+1 ][ rk ];
-				d = a[ s2 ][ 0 ] * ndu[ rk ][ pk ];
+				for ( l = 0; l < Lanes; l++ )
+				{
+					const ControlPoint & Pj = P[ span[ l ]-p+j ];
+					Nw = ders[ j*Lanes + l ] * Pj.weight();
+					for ( c = 0; c < N; c++ )
+						Cw[ c ][ l ] += Nw * Pj[ c ];
+					Cw[ N ][ l ] += Nw;
+				}
 			}
-			if ( rk >= -1 )
-				j1 = 1;
-			else
-				j1 = -rk;
-			if ( r-1 <= pk )
-				j2 = k - 1;
-			else
-				j2 = p - r;
-			for ( j = j1; j <= j2; j++ )
-			{
-				a[ s2 ][ j ] = ( a[ s1 ][ j ] - a[ s1 ][ j-1 ] ) / ndu[ pk+1 ][ rk+j ];
-				d += a[ s2 ][ j ] * ndu[ rk+j ][ pk ];
-			}
-			if ( r <= pk )
+			for ( l = 0; l < lanes; l++ )
+				for ( c = 0; c < N; c++ )
+					out[ first + l ][ c ] = Cw[ c ][ l ] / Cw[ N ][ l ];
+			continue;
+		}
+
+		basis::dersBasisFunsLanes<Lanes>( span, u, p, du, U.data(), ders );
+
+		// Homogeneous sums, then A4.2 per lane
+		for ( l = 0; l < lanes; l++ )
+		{
+			for ( d = 0; d <= k; d++ )
 			{
-				a[ s2 ][ k ] = -a[ s1 ][ k-1 ] / ndu[ pk+1 ][ r ];
-				d += a[ s2 ][ k ] * ndu[ r ][ pk ];
+				Aders[ d ] = ComputePoint();
+				wders[ d ] = 0.;
+				for ( j = 0; j <= p; j++ )
+				{
+					const ControlPoint & Pj = P[ span[ l ]-p+j ];
+					Nw = ders[ ( d*(p+1) + j )*Lanes + l ] * Pj.weight();
+					for ( c = 0; c < N; c++ )
+						Aders[ d ][ c ] += Nw * Pj[ c ];
+					wders[ d ] += Nw;
+				}
 			}
-			ders[ k ][ r ] = d;
-			// Switch rows
-			j = s1;
-			s1 = s2;
-			s2 = j;
+			basis::rationalDerivs( Aders, wders, k );
+			out[ first + l ] = Point( Aders[ k ] );
 		}
 	}
+}
 
-	// Multiply through by the correct factors
-	r = p;
-	for ( k = 1; k <= n; k++ )
+template <int N, class Real, class Compute>
+void NURBS<N, Real, Compute>::curvePoint( int span, int p, const std::vector<Real> & U, const std::vector<ControlPoint> & Pw, Real u, Point & C ) const
+{
+	Compute N_[ p+1 ], Cw[ N ];
+	Compute w, Nw;
+	int j, k;
+
+	GEOM_SCOPE( CurvePoint );
+
+	basis::basisFuns( span, (Compute)u, p, U.data(), N_ );
+	w = 0.;
+	for ( k = 0; k < N; k++ )
+		Cw[ k ] = 0.;
+	for ( j = 0; j <= p; j++ )
 	{
-		for ( j = 0; j <= p; j++ )
-			ders[ k ][ j ] *= r;
-		r *= ( p - k );
+		const ControlPoint & Pi = Pw[ span-p+j ];
+		Nw = N_[ j ] * Pi.weight();
+		for ( k = 0; k < N; k++ )
+			Cw[ k ] += Nw * Pi[ k ];
+		w += Nw;
 	}
+	// Divide by weight
+	for ( k = 0; k < N; k++ )
+		C[ k ] = Cw[ k ] / w;
 }
 
-template <int N, class Real>
-void NURBS<N, Real>::curveDerivs( int n, int p, const std::vector<Real> & U, const std::vector<Point> & P, Real u, int d, Point * CK ) const
+template <int N, class Real, class Compute>
+void NURBS<N, Real, Compute>::curveDerivs( int span, int p, const std::vector<Real> & U, const std::vector<ControlPoint> & P, Real u, int d, Point * CK ) const
 {
-	Matrix nders( d+1, p+1 );
-	int j, k, du, span;
+	typedef geom::Vector<N, Compute> ComputePoint;
+	Compute nders[ ( d+1 ) * ( p+1 ) ], wders[ d+1 ], Nw;
+	ComputePoint Aders[ d+1 ];
+	int j, k, l, du;
+
+	GEOM_SCOPE( CurveDerivs );
 
 	du = std::min( d, p );
 
-	span = findSpan( n, p, u, U );
-	dersBasisFuns( span, u, p, du, U, nders );
+	basis::dersBasisFuns( span, (Compute)u, p, du, U.data(), nders );
 
+	// Derivatives of the homogeneous curve (zero above the degree)
+	for ( k = 0; k <= d; k++ )
+		wders[ k ] = 0.;
 	for ( k = 0; k <= du; k++ )
 	{
 		for ( j = 0; j <= p; j++ )
-			CK[ k ] += P[ span-p+j ] * nders[ k ][ j ];
+		{
+			const ControlPoint & Pj = P[ span-p+j ];
+			Nw = nders[ k*(p+1) + j ] * Pj.weight();
+			for ( l = 0; l < N; l++ )
+				Aders[ k ][ l ] += Nw * Pj[ l ];
+			wders[ k ] += Nw;
+		}
 	}
+
+	basis::rationalDerivs( Aders, wders, d );
+	for ( k = 0; k <= d; k++ )
+		CK[ k ] = Point( Aders[ k ] );
 }
 
-template <int N, class Real>
-void NURBS<N, Real>::adjustParameter( Real & u ) const
+template <int N, class Real, class Compute>
+void NURBS<N, Real, Compute>::adjustParameter( Real & u ) const
 {
-	Real minKnot, maxKnot, total;
+	basis::adjustParameter( u, this->knotVector().front(), this->knotVector().back(), this->isClamped() );
+}
 
-	minKnot = this->knotVector().front();
-	maxKnot = this->knotVector().back();
+} // namespace
 
-	if ( this->isClamped() )
-	{
-		u = std::max( u, minKnot );
-		u = std::min( u, maxKnot );
-	}
-	else
-	{
-		total = fabs( maxKnot - minKnot );
-		while ( u < minKnot ) u += total;
-		while ( u >= maxKnot ) u -= total;
-	}
-}
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace curve
+{
+
+extern template class NURBS<2, float>;
+extern template class NURBS<3, float>;
+extern template class NURBS<4, float>;
+extern template class NURBS<2, double>;
+extern template class NURBS<3, double>;
+extern template class NURBS<4, double>;
+extern template class NURBS<2, float, double>;
+extern template class NURBS<3, float, double>;
+extern template class NURBS<4, float, double>;
 
 } // namespace
+#endif
 
 #endif
 
@@ -0,0 +1,80 @@
+/** -*- C++ -*-
+ * @file OSG.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef GEOM_OSG_HPP
+#define GEOM_OSG_HPP
+
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+// OpenSceneGraph
+
+#include <osg/Vec2>
+#include <osg/Vec3>
+#include <osg/Uniform>
+
+/**
+ * @brief Converts a geom::Vector<2> into a osg::Vec2.
+ */
+template<class Real>
+const geom::Vector<2, Real> & operator>>( const geom::Vector<2, Real> & u, osg::Vec2 & v )
+{
+	v.set( u[ 0 ], u[ 1 ] );
+	return u;
+}
+
+/**
+ * @brief Converts a geom::Vector<3> into a osg::Vec3.
+ */
+template<class Real>
+const geom::Vector<3, Real> & operator>>( const geom::Vector<3, Real> & u, osg::Vec3 & v )
+{
+	v.set( u[ 0 ], u[ 1 ], u[ 2 ] );
+	return u;
+}
+
+/**
+ * @brief Converts a geom::Matrix<2, 2> into a osg::Matrix2.
+ */
+template<class Real>
+const geom::Matrix<2, 2, Real> & operator>>( const geom::Matrix<2, 2, Real> & u, osg::Matrix2 & v )
+{
+	v.set( (const Real *)u.ptr() );
+	return u;
+}
+
+/**
+ * @brief Converts a geom::Matrix<3, 3> into a osg::Matrix3.
+ */
+template<class Real>
+const geom::Matrix<3, 3, Real> & operator>>( const geom::Matrix<3, 3, Real> & u, osg::Matrix3 & v )
+{
+	v.set( (const Real *)u.ptr() );
+	return u;
+}
+
+#endif
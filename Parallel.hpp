@@ -0,0 +1,130 @@
+/** -*- C++ -*-
+ * @file Parallel.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef GEOM_PARALLEL_HPP
+#define GEOM_PARALLEL_HPP
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <exception>
+#include <system_error>
+#include <new>
+#include <cstddef>
+#include <algorithm>
+
+namespace geom
+{
+
+/**
+ * @brief Resolves a requested number of threads.
+ * @param threads Requested number (0 = one per hardware thread).
+ * @param count Number of work items (no more threads than items).
+ * @return The number of threads to run, at least 1.
+ */
+inline unsigned threadCount( unsigned threads, std::size_t count )
+{
+	if ( threads == 0 )
+		threads = std::max( std::thread::hardware_concurrency(), 1u );
+	if ( count < threads )
+		threads = std::max( (unsigned)count, 1u );
+	return threads;
+}
+
+/**
+ * @brief Calls f( i, worker ) for every i in [0, count), on several threads.
+ *
+ * Items are handed out in chunks from a shared counter, so uneven items
+ * balance themselves. worker is the index of the calling thread, in
+ * [0, threadCount( threads, count )), for per-thread output buffers.
+ * With one thread, everything runs on the calling thread.
+ *
+ * If f throws, no more items are handed out; once every thread is
+ * joined, the first exception is rethrown on the calling thread. If some
+ * threads cannot be created, their items run on the others.
+ *
+ * @param count Number of items.
+ * @param threads Requested number of threads (0 = hardware threads).
+ * @param f The function, called as f( std::size_t, unsigned ).
+ * @param chunk Number of items taken at once.
+ */
+template <class FunctionType>
+void parallelFor( std::size_t count, unsigned threads, const FunctionType& f, std::size_t chunk = 16 )
+{
+	std::atomic<std::size_t> next( 0 );
+	std::vector<std::thread> pool;
+	std::exception_ptr error;
+	std::mutex mutex;
+	unsigned i;
+
+	threads = threadCount( threads, count );
+
+	auto work = [ & ]( unsigned worker )
+	{
+		std::size_t first, last, j;
+
+		try
+		{
+			while ( ( first = next.fetch_add( chunk, std::memory_order_relaxed ) ) < count )
+			{
+				last = std::min( first + chunk, count );
+				for ( j = first; j < last; j++ )
+					f( j, worker );
+			}
+		}
+		catch ( ... )
+		{
+			// Keep the first exception and stop the other threads
+			std::lock_guard<std::mutex> lock( mutex );
+			if ( !error )
+				error = std::current_exception();
+			next.store( count, std::memory_order_relaxed );
+		}
+	};
+
+	// Threads that cannot be created leave their items to the others
+	try
+	{
+		pool.reserve( threads - 1 );
+		for ( i = 1; i < threads; i++ )
+			pool.emplace_back( work, i );
+	}
+	catch ( const std::system_error & ) {}
+	catch ( const std::bad_alloc & ) {}
+
+	work( 0 );
+	for ( i = 0; i < pool.size(); i++ )
+		pool[ i ].join();
+
+	if ( error )
+		std::rethrow_exception( error );
+}
+
+} // namespace
+
+#endif
@@ -30,7 +30,9 @@
 #include "Vector.hpp"
 #include "Integral.hpp"
 #include "Simpson.hpp"
-#include <functional>
+#include "Functional.hpp"
+#include <memory>
+#include <type_traits>
 
 namespace curve
 {
@@ -41,10 +43,16 @@ namespace curve
  * A class template for parametric curves.
  */
 template <int N, class Real>
-class Parametric : public std::unary_function<Real, geom::Vector<N, Real> >
+class Parametric : public geom::UnaryFunction<Real, geom::Vector<N, Real> >
 {
 public:
 	typedef geom::Vector<N, Real> Point;
+	typedef Real Type;
+
+	/**
+	 * @brief Destructor.
+	 */
+	virtual ~Parametric() {}
 
 	/**
 	 * @brief Computes C(t).
@@ -72,30 +80,23 @@ public:
 	Real length( const Real& a, const Real& b, const IntegralType& integral ) const;
 
 	/**
-	 * @brief Computes the arc length between a and b with Simpson integration.
+	 * @brief Computes the arc length between a and b and reports statistics.
 	 * @param a
 	 * @param b
+	 * @param integral An Integral object.
+	 * @param result Statistics of the integration.
 	 * @return The length between a and b.
 	 */
-	Real length( const Real& a, const Real& b ) const;
+	template <class IntegralType>
+	Real length( const Real& a, const Real& b, const IntegralType& integral, integral::Result<Real>& result ) const;
 
-private:
 	/**
-	 * @brief Computes the norm of the speed as a functor (std::unary_function).
+	 * @brief Computes the arc length between a and b with Simpson integration.
+	 * @param a
+	 * @param b
+	 * @return The length between a and b.
 	 */
-	class Speed : public std::unary_function<Real, Real>
-	{
-	public:
-		Speed( const Parametric<N, Real> * p ) : _p( p ) {}
-		Real operator()( const Real& t ) const
-		{
-			Point v;
-			v = _p->derivative( t, 1 );
-			return v.length();
-		}
-	private:
-		const Parametric<N, Real> * _p;
-	};
+	Real length( const Real& a, const Real& b ) const;
 };
 
 /**
@@ -116,14 +117,203 @@ public:
 	}
 };
 
+/**
+ * @brief Whether Static<CurveType> may bypass the virtual table.
+ *
+ * Only if no derived class can override the evaluation: non-polymorphic
+ * types and final classes (e.g. NURBS).
+ */
+template <class CurveType>
+struct IsStatic : std::integral_constant<bool, !std::is_abstract<CurveType>::value &&
+	( !std::is_polymorphic<CurveType>::value || std::is_final<CurveType>::value )>
+{
+};
+
+/**
+ * @brief Statically dispatched curve evaluation.
+ *
+ * Calls the operator() and derivative() of CurveType itself, bypassing the
+ * virtual table, so that evaluation can be inlined in generic algorithms.
+ * Types that may be overridden (abstract or non-final polymorphic types,
+ * e.g. Parametric, Spline or SplineView) are evaluated through virtual
+ * calls (see IsStatic).
+ */
+template <class CurveType, bool Virtual = !IsStatic<CurveType>::value>
+struct Static
+{
+	typedef typename CurveType::Point Point;
+	typedef typename CurveType::Type Real;
+
+	static inline Point point( const CurveType& curve, const Real& t )
+	{
+		return curve.CurveType::operator()( t );
+	}
+
+	static inline Point derivative( const CurveType& curve, const Real& t, int k = 1 )
+	{
+		return curve.CurveType::derivative( t, k );
+	}
+};
+
+/**
+ * @brief Curve evaluation through virtual calls.
+ */
+template <class CurveType>
+struct Static<CurveType, true>
+{
+	typedef typename CurveType::Point Point;
+	typedef typename CurveType::Type Real;
+
+	static inline Point point( const CurveType& curve, const Real& t )
+	{
+		return curve( t );
+	}
+
+	static inline Point derivative( const CurveType& curve, const Real& t, int k = 1 )
+	{
+		return curve.derivative( t, k );
+	}
+};
+
+/**
+ * @brief Computes the norm of the speed as a functor.
+ *
+ * The norm is computed and returned as Compute (e.g. double for float
+ * curves integrated in double).
+ */
+template <class CurveType, class Compute = typename CurveType::Type>
+class Speed : public geom::UnaryFunction<typename CurveType::Type, Compute>
+{
+public:
+	typedef typename CurveType::Type Real;
+
+	Speed( const CurveType & curve ) : _curve( &curve ) {}
+
+	inline Compute operator()( const Real& t ) const
+	{
+		return Static<CurveType>::derivative( *_curve, t, 1 ).template length<Compute>();
+	}
+
+private:
+	const CurveType * _curve;
+};
+
+/**
+ * @brief Computes the arc length of a curve between a and b.
+ *
+ * The curve is evaluated with Static<CurveType>, so a concrete CurveType
+ * lets the integral inline the whole evaluation. The speed is computed in
+ * the ComputeType of the integral.
+ * @param curve The curve.
+ * @param a
+ * @param b
+ * @param integral An Integral object.
+ * @return The length between a and b.
+ */
+template <class CurveType, class IntegralType>
+inline typename CurveType::Type length( const CurveType& curve, const typename CurveType::Type& a, const typename CurveType::Type& b, const IntegralType& integral )
+{
+	return integral( Speed<CurveType, typename IntegralType::ComputeType>( curve ), a, b );
+}
+
+/**
+ * @brief Computes the arc length of a curve and reports statistics.
+ * @param curve The curve.
+ * @param a
+ * @param b
+ * @param integral An Integral object.
+ * @param result Statistics of the integration.
+ * @return The length between a and b.
+ */
+template <class CurveType, class IntegralType>
+inline typename CurveType::Type length( const CurveType& curve, const typename CurveType::Type& a, const typename CurveType::Type& b, const IntegralType& integral, integral::Result<typename CurveType::Type>& result )
+{
+	return integral( Speed<CurveType, typename IntegralType::ComputeType>( curve ), a, b, result );
+}
+
+/**
+ * @brief Wraps a curve into the virtual Parametric interface.
+ *
+ * Allows statically dispatched curve types (not derived from Parametric) to
+ * be stored in heterogeneous containers of Parametric.
+ */
+template <int N, class Real, class CurveType>
+class Wrapper : public Parametric<N, Real>
+{
+public:
+	typedef geom::Vector<N, Real> Point;
+
+	Wrapper( const CurveType & curve ) : _curve( curve ) {}
+
+	virtual Point operator()( const Real& t ) const
+	{
+		return Static<CurveType>::point( _curve, t );
+	}
+
+	virtual Point derivative( const Real& t, int k = 1 ) const
+	{
+		return Static<CurveType>::derivative( _curve, t, k );
+	}
+
+	inline const CurveType & getCurve() const { return _curve; }
+
+private:
+	CurveType _curve;
+};
+
+/**
+ * @brief Makes a shared immutable copy of an object.
+ * @param object The object to copy (once).
+ * @return A reference-counted pointer to the copy.
+ */
+template <class Type>
+inline std::shared_ptr<const Type> share( const Type & object )
+{
+	return std::make_shared<const Type>( object );
+}
+
+/**
+ * @brief Shares an already shared object (no copy).
+ * @param object The shared object.
+ * @return The same object, as immutable.
+ */
+template <class Type>
+inline std::shared_ptr<const Type> share( const std::shared_ptr<Type> & object )
+{
+	return object;
+}
+
+/**
+ * @brief Type of the object shared by share( object ).
+ *
+ * Type itself, or the (non-const) pointee of a std::shared_ptr.
+ */
+template <class Type>
+struct Shared
+{
+	typedef Type Object;
+};
+
+template <class Type>
+struct Shared<std::shared_ptr<Type> >
+{
+	typedef typename std::remove_const<Type>::type Object;
+};
+
 // -----------------------------------------------------------------------------
 
 template <int N, class Real>
 template <class IntegralType>
 Real Parametric<N, Real>::length( const Real& a, const Real& b, const IntegralType& integral ) const
 {
-	Speed norm( this );
-	return integral( norm, a, b );
+	return curve::length( *this, a, b, integral );
+}
+
+template <int N, class Real>
+template <class IntegralType>
+Real Parametric<N, Real>::length( const Real& a, const Real& b, const IntegralType& integral, integral::Result<Real>& result ) const
+{
+	return curve::length( *this, a, b, integral, result );
 }
 
 template <int N, class Real>
@@ -134,5 +324,21 @@ Real Parametric<N, Real>::length( const Real& a, const Real& b ) const
 
 } // namespace
 
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace curve
+{
+
+extern template class Parametric<2, float>;
+extern template class Parametric<3, float>;
+extern template class Parametric<4, float>;
+extern template class Parametric<2, double>;
+extern template class Parametric<3, double>;
+extern template class Parametric<4, double>;
+
+} // namespace
+#endif
+
 #endif
 
@@ -0,0 +1,307 @@
+/** -*- C++ -*-
+ * @file Quaternion.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef GEOM_QUATERNION_HPP
+#define GEOM_QUATERNION_HPP
+
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include <cmath>
+
+namespace geom
+{
+
+/**
+ * @brief Quaternion class template.
+ *
+ * q = w + x i + y j + z k. Unit quaternions represent rotations in 4
+ * values instead of the 9 of a 3x3 matrix; q and -q are the same rotation.
+ */
+template <class Real = float>
+class Quaternion
+{
+public:
+	/**
+	 * @brief Identity constructor.
+	 */
+	Quaternion()
+	{
+		_q[ 0 ] = 1;
+		_q[ 1 ] = _q[ 2 ] = _q[ 3 ] = 0;
+	}
+
+	/**
+	 * @brief Constructor from four components.
+	 */
+	Quaternion( const Real & w, const Real & x, const Real & y, const Real & z )
+	{
+		_q[ 0 ] = w;
+		_q[ 1 ] = x;
+		_q[ 2 ] = y;
+		_q[ 3 ] = z;
+	}
+
+	/**
+	 * @brief Constructor from a rotation matrix (Shepperd's method).
+	 *
+	 * The branch on the largest diagonal term avoids dividing by a small
+	 * number.
+	 * @param m An orthonormal matrix of determinant 1 (e.g. the T, N, B
+	 * frame of a curve, in columns).
+	 */
+	explicit Quaternion( const Matrix<3, 3, Real> & m )
+	{
+		Real tr, s;
+
+		tr = m[ 0 ][ 0 ] + m[ 1 ][ 1 ] + m[ 2 ][ 2 ];
+		if ( tr > 0 )
+		{
+			s = std::sqrt( tr + 1 ) * 2;
+			_q[ 0 ] = s / 4;
+			_q[ 1 ] = ( m[ 2 ][ 1 ] - m[ 1 ][ 2 ] ) / s;
+			_q[ 2 ] = ( m[ 0 ][ 2 ] - m[ 2 ][ 0 ] ) / s;
+			_q[ 3 ] = ( m[ 1 ][ 0 ] - m[ 0 ][ 1 ] ) / s;
+		}
+		else if ( m[ 0 ][ 0 ] > m[ 1 ][ 1 ] && m[ 0 ][ 0 ] > m[ 2 ][ 2 ] )
+		{
+			s = std::sqrt( 1 + m[ 0 ][ 0 ] - m[ 1 ][ 1 ] - m[ 2 ][ 2 ] ) * 2;
+			_q[ 0 ] = ( m[ 2 ][ 1 ] - m[ 1 ][ 2 ] ) / s;
+			_q[ 1 ] = s / 4;
+			_q[ 2 ] = ( m[ 0 ][ 1 ] + m[ 1 ][ 0 ] ) / s;
+			_q[ 3 ] = ( m[ 0 ][ 2 ] + m[ 2 ][ 0 ] ) / s;
+		}
+		else if ( m[ 1 ][ 1 ] > m[ 2 ][ 2 ] )
+		{
+			s = std::sqrt( 1 + m[ 1 ][ 1 ] - m[ 0 ][ 0 ] - m[ 2 ][ 2 ] ) * 2;
+			_q[ 0 ] = ( m[ 0 ][ 2 ] - m[ 2 ][ 0 ] ) / s;
+			_q[ 1 ] = ( m[ 0 ][ 1 ] + m[ 1 ][ 0 ] ) / s;
+			_q[ 2 ] = s / 4;
+			_q[ 3 ] = ( m[ 1 ][ 2 ] + m[ 2 ][ 1 ] ) / s;
+		}
+		else
+		{
+			s = std::sqrt( 1 + m[ 2 ][ 2 ] - m[ 0 ][ 0 ] - m[ 1 ][ 1 ] ) * 2;
+			_q[ 0 ] = ( m[ 1 ][ 0 ] - m[ 0 ][ 1 ] ) / s;
+			_q[ 1 ] = ( m[ 0 ][ 2 ] + m[ 2 ][ 0 ] ) / s;
+			_q[ 2 ] = ( m[ 1 ][ 2 ] + m[ 2 ][ 1 ] ) / s;
+			_q[ 3 ] = s / 4;
+		}
+		normalize();
+	}
+
+	/**
+	 * @brief Rotation of an angle around an axis.
+	 * @param axis The axis (unit vector).
+	 * @param angle The angle in radians.
+	 */
+	static Quaternion fromAxisAngle( const Vector<3, Real> & axis, const Real & angle )
+	{
+		Real s = std::sin( angle / 2 );
+		return Quaternion( std::cos( angle / 2 ), axis[ 0 ] * s, axis[ 1 ] * s, axis[ 2 ] * s );
+	}
+
+	inline const Real & w() const { return _q[ 0 ]; }
+	inline const Real & x() const { return _q[ 1 ]; }
+	inline const Real & y() const { return _q[ 2 ]; }
+	inline const Real & z() const { return _q[ 3 ]; }
+
+	/**
+	 * @brief Returns the i-th component (w, x, y, z).
+	 */
+	inline const Real & operator[]( int i ) const
+	{
+		return _q[ i ];
+	}
+
+	inline Real & operator[]( int i )
+	{
+		return _q[ i ];
+	}
+
+	/**
+	 * @brief Returns the rotation matrix.
+	 */
+	Matrix<3, 3, Real> matrix() const
+	{
+		const Real & w = _q[ 0 ], & x = _q[ 1 ], & y = _q[ 2 ], & z = _q[ 3 ];
+		Matrix<3, 3, Real> m;
+
+		m[ 0 ][ 0 ] = 1 - 2 * ( y * y + z * z );
+		m[ 0 ][ 1 ] = 2 * ( x * y - w * z );
+		m[ 0 ][ 2 ] = 2 * ( x * z + w * y );
+		m[ 1 ][ 0 ] = 2 * ( x * y + w * z );
+		m[ 1 ][ 1 ] = 1 - 2 * ( x * x + z * z );
+		m[ 1 ][ 2 ] = 2 * ( y * z - w * x );
+		m[ 2 ][ 0 ] = 2 * ( x * z - w * y );
+		m[ 2 ][ 1 ] = 2 * ( y * z + w * x );
+		m[ 2 ][ 2 ] = 1 - 2 * ( x * x + y * y );
+		return m;
+	}
+
+	/**
+	 * @brief Rotates a vector (unit quaternion).
+	 *
+	 * v' = v + 2 w ( u ^ v ) + 2 u ^ ( u ^ v ), with u = ( x, y, z ).
+	 */
+	Vector<3, Real> rotate( const Vector<3, Real> & v ) const
+	{
+		Vector<3, Real> u( _q + 1 ), c;
+
+		c = ( u ^ v ) * 2;
+		return v + c * _q[ 0 ] + ( u ^ c );
+	}
+
+	/**
+	 * @brief Hamilton product (rotation by q, then by this).
+	 */
+	const Quaternion operator*( const Quaternion & q ) const
+	{
+		return Quaternion(
+			_q[ 0 ] * q._q[ 0 ] - _q[ 1 ] * q._q[ 1 ] - _q[ 2 ] * q._q[ 2 ] - _q[ 3 ] * q._q[ 3 ],
+			_q[ 0 ] * q._q[ 1 ] + _q[ 1 ] * q._q[ 0 ] + _q[ 2 ] * q._q[ 3 ] - _q[ 3 ] * q._q[ 2 ],
+			_q[ 0 ] * q._q[ 2 ] - _q[ 1 ] * q._q[ 3 ] + _q[ 2 ] * q._q[ 0 ] + _q[ 3 ] * q._q[ 1 ],
+			_q[ 0 ] * q._q[ 3 ] + _q[ 1 ] * q._q[ 2 ] - _q[ 2 ] * q._q[ 1 ] + _q[ 3 ] * q._q[ 0 ] );
+	}
+
+	/**
+	 * @brief Conjugate (inverse rotation of a unit quaternion).
+	 */
+	inline const Quaternion conjugate() const
+	{
+		return Quaternion( _q[ 0 ], -_q[ 1 ], -_q[ 2 ], -_q[ 3 ] );
+	}
+
+	inline const Quaternion operator+( const Quaternion & q ) const
+	{
+		return Quaternion( _q[ 0 ] + q._q[ 0 ], _q[ 1 ] + q._q[ 1 ], _q[ 2 ] + q._q[ 2 ], _q[ 3 ] + q._q[ 3 ] );
+	}
+
+	inline const Quaternion operator-() const
+	{
+		return Quaternion( -_q[ 0 ], -_q[ 1 ], -_q[ 2 ], -_q[ 3 ] );
+	}
+
+	inline const Quaternion operator*( const Real & r ) const
+	{
+		return Quaternion( _q[ 0 ] * r, _q[ 1 ] * r, _q[ 2 ] * r, _q[ 3 ] * r );
+	}
+
+	/**
+	 * @brief Dot product of the four components.
+	 */
+	inline Real dot( const Quaternion & q ) const
+	{
+		return _q[ 0 ] * q._q[ 0 ] + _q[ 1 ] * q._q[ 1 ] + _q[ 2 ] * q._q[ 2 ] + _q[ 3 ] * q._q[ 3 ];
+	}
+
+	inline Real length() const { return std::sqrt( dot( *this ) ); }
+
+	inline void normalize()
+	{
+		Real r = 1 / length();
+		for ( int i = 0; i < 4; i++ )
+			_q[ i ] *= r;
+	}
+
+private:
+	Real _q[ 4 ]; /**< Components ( w, x, y, z ). */
+};
+
+/**
+ * @brief Normalized linear interpolation, along the shortest arc.
+ *
+ * Cheaper than slerp, but the angular speed is not constant (the error
+ * stays small between close rotations, e.g. consecutive frames).
+ * @param a First unit quaternion.
+ * @param b Second unit quaternion.
+ * @param t Parameter in [0, 1].
+ */
+template <class Real>
+Quaternion<Real> nlerp( const Quaternion<Real> & a, const Quaternion<Real> & b, const Real & t )
+{
+	Quaternion<Real> q;
+
+	q = a * ( 1 - t ) + b * ( a.dot( b ) < 0 ? -t : t );
+	q.normalize();
+	return q;
+}
+
+/**
+ * @brief Spherical linear interpolation, along the shortest arc.
+ *
+ * Constant angular speed; falls back to nlerp for close rotations.
+ * @param a First unit quaternion.
+ * @param b Second unit quaternion.
+ * @param t Parameter in [0, 1].
+ */
+template <class Real>
+Quaternion<Real> slerp( const Quaternion<Real> & a, const Quaternion<Real> & b, const Real & t )
+{
+	Real d, theta, s;
+
+	d = a.dot( b );
+	s = ( d < 0 ? -1 : 1 );
+	d *= s;
+	if ( d > (Real)0.9995 )
+		return nlerp( a, b, t );
+
+	theta = std::acos( d );
+	return a * ( std::sin( ( 1 - t ) * theta ) / std::sin( theta ) ) + b * ( s * std::sin( t * theta ) / std::sin( theta ) );
+}
+
+typedef Quaternion<float> Quaternionf;
+typedef Quaternion<double> Quaterniond;
+
+} // namespace
+
+// Complements
+
+#include <ostream>
+
+/**
+ * @brief Displays components ( w, x, y, z ).
+ */
+template<class Real>
+std::ostream & operator<<( std::ostream & os, const geom::Quaternion<Real> & q )
+{
+	os << "(" << q[ 0 ] << ", " << q[ 1 ] << ", " << q[ 2 ] << ", " << q[ 3 ] << ")";
+	return os;
+}
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace geom
+{
+
+extern template class Quaternion<float>;
+extern template class Quaternion<double>;
+
+} // namespace
+#endif
+
+#endif
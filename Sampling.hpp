@@ -0,0 +1,367 @@
+/** -*- C++ -*-
+ * @file Sampling.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef CURVE_SAMPLING_HPP
+#define CURVE_SAMPLING_HPP
+
+#include "Spline.hpp"
+#include "Basis.hpp"
+#include "Parallel.hpp"
+#include "Vector.hpp"
+#include "Instrument.hpp"
+#include <vector>
+#include <stdexcept>
+#include <cstddef>
+#include <algorithm>
+
+namespace curve
+{
+
+/**
+ * @brief Sampling plan: sparse basis matrix at fixed parameters.
+ *
+ * For a fixed knot vector and parameter set, stores the span and the p+1
+ * non-zero basis functions (and optionally their derivatives) of each
+ * sample. Evaluating the samples is then a sparse matrix product with the
+ * control points, with no span search nor basis computation, so control
+ * points (and weights) may change between evaluations.
+ *
+ * For repeated evaluations, bind() the control points once: the size check
+ * and the scan of the weights are then not repeated at each evaluation.
+ */
+template <int N, class Real = float>
+class SamplingPlan
+{
+public:
+	typedef geom::Vector<N, Real> Point;
+	typedef geom::WeightedPoint<N, Real> ControlPoint;
+
+	SamplingPlan() : _degree( 0 ), _derivatives( 0 ), _pointCount( 0 ), _points( 0 ), _rational( false ) {}
+
+	/**
+	 * @param curve The curve (only its degree and knots are used).
+	 * @param parameters The sample parameters.
+	 * @param derivatives Highest derivative order to evaluate.
+	 */
+	SamplingPlan( const Spline<N, Real> & curve, const std::vector<Real> & parameters, int derivatives = 0 ) :
+		_points( 0 ), _rational( false )
+	{
+		build( curve, parameters, derivatives );
+	}
+
+	/**
+	 * @brief Computes the spans and basis functions of every sample.
+	 *
+	 * Unbinds the control points.
+	 * @param curve The curve (only its degree and knots are used).
+	 * @param parameters The sample parameters.
+	 * @param derivatives Highest derivative order to evaluate.
+	 */
+	void build( const Spline<N, Real> & curve, const std::vector<Real> & parameters, int derivatives = 0 );
+
+	inline std::size_t size() const     { return _spans.size(); }
+	inline int getDegree() const        { return _degree; }
+	inline int getDerivatives() const   { return _derivatives; }
+	inline std::size_t pointCount() const { return _pointCount; }
+
+	/**
+	 * @brief Returns the knot span of sample i.
+	 */
+	inline int span( std::size_t i ) const { return _spans[ i ]; }
+
+	/**
+	 * @brief Returns the p+1 basis functions (k-th derivatives) of sample i.
+	 *
+	 * Coefficients of control points span-p to span.
+	 */
+	inline const Real * basis( std::size_t i, int k = 0 ) const
+	{
+		return &_basis[ ( i * ( _derivatives + 1 ) + k ) * ( _degree + 1 ) ];
+	}
+
+	/**
+	 * @brief Binds the control points used by evaluate( out, k, threads ).
+	 *
+	 * The array is not copied: it must outlive the binding, and be bound
+	 * again if it is resized or if its weights change.
+	 * @param P Control points (as many as when the plan was built).
+	 * @throw std::invalid_argument If P does not have pointCount() points.
+	 */
+	void bind( const std::vector<ControlPoint> & P );
+
+	/**
+	 * @brief Evaluates C(k) at every sample, with the bound control points.
+	 * @param out Output array of size() points.
+	 * @param k Derivative order, k <= getDerivatives().
+	 * @param threads Number of threads (0 = hardware threads).
+	 * @throw std::invalid_argument If k is out of range.
+	 * @throw std::runtime_error If no control points are bound.
+	 */
+	void evaluate( Point * out, int k = 0, unsigned threads = 1 ) const;
+
+	/**
+	 * @brief Evaluates C(k) at every sample.
+	 *
+	 * Checks P and scans its weights at each call; see bind().
+	 * @param P Control points (as many as when the plan was built).
+	 * @param out Output array of size() points.
+	 * @param k Derivative order, k <= getDerivatives().
+	 * @param threads Number of threads (0 = hardware threads).
+	 * @throw std::invalid_argument If P does not have pointCount() points or k is out of range.
+	 */
+	void evaluate( const std::vector<ControlPoint> & P, Point * out, int k = 0, unsigned threads = 1 ) const;
+
+	/**
+	 * @brief Evaluates C(k) at every sample, with the control points of a curve.
+	 * @param curve A curve with the degree and knots of the plan.
+	 * @param out Output array, resized to size().
+	 * @param k Derivative order, k <= getDerivatives().
+	 * @param threads Number of threads (0 = hardware threads).
+	 * @throw std::invalid_argument If the curve does not have pointCount() points or k is out of range.
+	 */
+	void evaluate( const Spline<N, Real> & curve, std::vector<Point> & out, int k = 0, unsigned threads = 1 ) const
+	{
+		out.resize( size() );
+		evaluate( curve.controlPoints(), out.data(), k, threads );
+	}
+
+private:
+	std::vector<int> _spans;
+	std::vector<Real> _basis;   /**< Per sample: derivatives+1 rows of p+1 values. */
+	int _degree;
+	int _derivatives;
+	std::size_t _pointCount;
+	const std::vector<ControlPoint> * _points; /**< Bound control points, or null. */
+	bool _rational;                            /**< The bound control points have weights != 1. */
+
+	/**
+	 * @brief Sum of row k of sample i times the control points.
+	 */
+	inline void product( const ControlPoint * P, std::size_t i, int k, bool rational, Real * C, Real & w ) const;
+
+	/**
+	 * @brief Checks the number of control points.
+	 */
+	void check( const std::vector<ControlPoint> & P ) const;
+
+	/**
+	 * @brief Checks if some weight is not 1.
+	 */
+	static bool isRational( const std::vector<ControlPoint> & P );
+
+	/**
+	 * @brief Evaluates C(k) at every sample, once the arguments are checked.
+	 */
+	void evaluatePoints( const ControlPoint * P, bool rational, Point * out, int k, unsigned threads ) const;
+
+	/**
+	 * @brief Samples per thread task, and per basis computation.
+	 */
+	enum { Chunk = 256, Lanes = 8 };
+};
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+void SamplingPlan<N, Real>::build( const Spline<N, Real> & curve, const std::vector<Real> & parameters, int derivatives )
+{
+	const std::vector<Real> & U = curve.knotVector();
+	std::size_t i, first, lanes, l, rows;
+	int p, du, j, span[ Lanes ];
+	Real u[ Lanes ];
+
+	p = curve.getDegree();
+	du = std::min( derivatives, p );
+	rows = ( derivatives + 1 ) * ( p + 1 );
+
+	_degree = p;
+	_derivatives = derivatives;
+	_pointCount = curve.controlPoints().size();
+	_points = 0;
+	_rational = false;
+	_spans.resize( parameters.size() );
+	_basis.assign( parameters.size() * rows, 0. );
+
+	Real ders[ ( du + 1 ) * ( p + 1 ) * Lanes ];
+
+	// Lanes parameters per basis computation
+	for ( first = 0; first < parameters.size(); first += Lanes )
+	{
+		lanes = std::min( (std::size_t)Lanes, parameters.size() - first );
+		for ( l = 0; l < Lanes; l++ )
+		{
+			u[ l ] = parameters[ first + std::min( l, lanes - 1 ) ];
+			basis::adjustParameter( u[ l ], U.front(), U.back(), curve.isClamped() );
+			span[ l ] = l ? curve.findSpan( u[ l ], span[ l-1 ] ) : curve.findSpan( u[ l ] );
+		}
+
+		if ( derivatives == 0 )
+			basis::basisFunsLanes<Lanes>( span, u, p, U.data(), ders );
+		else
+			basis::dersBasisFunsLanes<Lanes>( span, u, p, du, U.data(), ders );
+
+		// Derivatives above the degree stay zero
+		for ( l = 0; l < lanes; l++ )
+		{
+			i = first + l;
+			_spans[ i ] = span[ l ];
+			for ( j = 0; j < ( du + 1 ) * ( p + 1 ); j++ )
+				_basis[ i * rows + j ] = ders[ j * Lanes + l ];
+		}
+	}
+}
+
+template <int N, class Real>
+inline void SamplingPlan<N, Real>::product( const ControlPoint * P, std::size_t i, int k, bool rational, Real * C, Real & w ) const
+{
+	const Real * row = basis( i, k );
+	Real Nw;
+	int j, l, p;
+
+	p = _degree;
+	P += _spans[ i ] - p;
+
+	for ( l = 0; l < N; l++ )
+		C[ l ] = 0.;
+	w = 0.;
+	for ( j = 0; j <= p; j++ )
+	{
+		Nw = rational ? row[ j ] * P[ j ].weight() : row[ j ];
+		for ( l = 0; l < N; l++ )
+			C[ l ] += Nw * P[ j ][ l ];
+		w += Nw;
+	}
+}
+
+template <int N, class Real>
+void SamplingPlan<N, Real>::check( const std::vector<ControlPoint> & P ) const
+{
+	if ( P.size() != _pointCount )
+		throw std::invalid_argument( "curve::SamplingPlan: wrong number of control points" );
+}
+
+template <int N, class Real>
+bool SamplingPlan<N, Real>::isRational( const std::vector<ControlPoint> & P )
+{
+	std::size_t i;
+
+	for ( i = 0; i < P.size(); i++ )
+	{
+		if ( P[ i ].weight() != 1 )
+			return true;
+	}
+	return false;
+}
+
+template <int N, class Real>
+void SamplingPlan<N, Real>::bind( const std::vector<ControlPoint> & P )
+{
+	check( P );
+	_points = &P;
+	_rational = isRational( P );
+}
+
+template <int N, class Real>
+void SamplingPlan<N, Real>::evaluate( Point * out, int k, unsigned threads ) const
+{
+	if ( !_points )
+		throw std::runtime_error( "curve::SamplingPlan: no control points bound" );
+	evaluatePoints( _points->data(), _rational, out, k, threads );
+}
+
+template <int N, class Real>
+void SamplingPlan<N, Real>::evaluate( const std::vector<ControlPoint> & P, Point * out, int k, unsigned threads ) const
+{
+	check( P );
+	evaluatePoints( P.data(), isRational( P ), out, k, threads );
+}
+
+template <int N, class Real>
+void SamplingPlan<N, Real>::evaluatePoints( const ControlPoint * P, bool rational, Point * out, int k, unsigned threads ) const
+{
+	if ( k < 0 || k > _derivatives )
+		throw std::invalid_argument( "curve::SamplingPlan: derivative order out of range" );
+
+	GEOM_SCOPE( Sampling );
+
+	geom::parallelFor( ( size() + Chunk - 1 ) / Chunk, threads, [ & ]( std::size_t c, unsigned )
+	{
+		Point Aders[ k+1 ];
+		Real wders[ k+1 ], w;
+		std::size_t first, last, s;
+		int d;
+
+		first = c * Chunk;
+		last = std::min( first + Chunk, size() );
+
+		if ( !rational )
+		{
+			// Plain sparse product
+			for ( s = first; s < last; s++ )
+				product( P, s, k, false, &out[ s ][ 0 ], w );
+		}
+		else if ( k == 0 )
+		{
+			for ( s = first; s < last; s++ )
+			{
+				product( P, s, 0, true, &out[ s ][ 0 ], w );
+				out[ s ] /= w;
+			}
+		}
+		else
+		{
+			// Derivatives of the homogeneous curve, then A4.2
+			for ( s = first; s < last; s++ )
+			{
+				for ( d = 0; d <= k; d++ )
+					product( P, s, d, true, &Aders[ d ][ 0 ], wders[ d ] );
+				basis::rationalDerivs( Aders, wders, k );
+				out[ s ] = Aders[ k ];
+			}
+		}
+	}, 1 );
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace curve
+{
+
+extern template class SamplingPlan<2, float>;
+extern template class SamplingPlan<3, float>;
+extern template class SamplingPlan<4, float>;
+extern template class SamplingPlan<2, double>;
+extern template class SamplingPlan<3, double>;
+extern template class SamplingPlan<4, double>;
+
+} // namespace
+#endif
+
+#endif
@@ -28,75 +28,135 @@
 #define INTEGRAL_SIMPSON_HPP
 
 #include "Integral.hpp"
+#include "Instrument.hpp"
 #include <cmath>
+#include <cassert>
+#include <algorithm>
 
 namespace integral
 {
 
 /**
  * @brief Adaptive Simpson integral class.
+ *
+ * Compute is the type of the interval bounds and of the accumulated sums,
+ * e.g. double to integrate float functions without losing accuracy on
+ * long ranges. The function is still called with Real parameters.
  */
-template <class Real = float>
-class Simpson : public Integral<Real>
+template <class Real = float, class Compute = Real>
+class Simpson : public Integral<Real, Compute>
 {
 public:
-	Simpson( Real accuracy = 1e-6, int max = 5 ) :
-		Integral<Real>(), _accuracy( accuracy ), _maxRecursionDepth( max ) {}
+	/**
+	 * @brief Constructor.
+	 * @param accuracy Absolute accuracy of the result.
+	 * @param max Maximum recursion depth (>= 1); depth 1 splits [a, b] once.
+	 */
+	Simpson( Real accuracy = 1e-6, int max = 6 ) :
+		Integral<Real, Compute>(), _accuracy( accuracy ), _maxRecursionDepth( max )
+	{
+		assert( max >= 1 );
+	}
 
 	template <class FunctionType>
 	Real operator()( const FunctionType& f, const Real& a, const Real& b ) const;
 
+	/**
+	 * @brief Computes the integral and reports statistics.
+	 * @param result Value, error estimate, evaluations, depth and convergence.
+	 * @return The value of the integral.
+	 */
+	template <class FunctionType>
+	Real operator()( const FunctionType& f, const Real& a, const Real& b, Result<Real>& result ) const;
+
 	Real getAccuracy() const                 { return _accuracy; }
 	void setAccuracy( const Real& accuracy ) { _accuracy = accuracy; }
 	int getMaxRecursionDepth() const         { return _maxRecursionDepth; }
-	void setMaxRecursionDepth( int max )     { _maxRecursionDepth = max; }
+	void setMaxRecursionDepth( int max )     { assert( max >= 1 ); _maxRecursionDepth = max; }
 
 protected:
 	Real _accuracy;
 	int _maxRecursionDepth;
 
 	template <class FunctionType>
-	Real aux( const FunctionType& f, const Real& a, const Real& b, const Real& eps, const Real& S, const Real& fa, const Real& fb, const Real& fc, const int& bottom ) const;
+	Compute aux( const FunctionType& f, const Compute& a, const Compute& b, const Compute& eps, const Compute& S, const Compute& fa, const Compute& fb, const Compute& fc, const int& bottom, Result<Real> * result ) const;
 };
 
 // -----------------------------------------------------------------------------
 
-template <class Real>
+template <class Real, class Compute>
 template <class FunctionType>
-Real Simpson<Real>::operator()( const FunctionType& f, const Real& a, const Real& b ) const
+Real Simpson<Real, Compute>::operator()( const FunctionType& f, const Real& a, const Real& b ) const
 {
-	Real c, h, fa, fb, fc, S;
+	Compute c, h, fa, fb, fc, S;
 
-	c = ( a + b ) / 2.;
-	h = b - a;
+	GEOM_SCOPE( Simpson );
+
+	c = ( (Compute)a + b ) / 2.;
+	h = (Compute)b - a;
 	fa = f( a );
 	fb = f( b );
-	fc = f( c );
+	fc = f( (Real)c );
 	S = ( h / 6 ) * ( fa + 4 * fc + fb );
-	return aux( f, a, b, _accuracy, S, fa, fb, fc, _maxRecursionDepth );
+	return (Real)aux( f, a, b, _accuracy, S, fa, fb, fc, _maxRecursionDepth, 0 );
 }
 
-template <class Real>
+template <class Real, class Compute>
 template <class FunctionType>
-Real Simpson<Real>::aux( const FunctionType& f, const Real& a, const Real& b, const Real& eps, const Real& S, const Real& fa, const Real& fb, const Real& fc, const int& bottom ) const
+Real Simpson<Real, Compute>::operator()( const FunctionType& f, const Real& a, const Real& b, Result<Real>& result ) const
 {
-	Real c, d, e, h, fd, fe, Sleft, Sright, S2;
+	Compute c, h, fa, fb, fc, S;
+
+	GEOM_SCOPE( Simpson );
+
+	result = Result<Real>();
+	c = ( (Compute)a + b ) / 2.;
+	h = (Compute)b - a;
+	fa = f( a );
+	fb = f( b );
+	fc = f( (Real)c );
+	S = ( h / 6 ) * ( fa + 4 * fc + fb );
+	result.evaluations = 3;
+	result.value = (Real)aux( f, a, b, _accuracy, S, fa, fb, fc, _maxRecursionDepth, &result );
+	return result.value;
+}
+
+template <class Real, class Compute>
+template <class FunctionType>
+Compute Simpson<Real, Compute>::aux( const FunctionType& f, const Compute& a, const Compute& b, const Compute& eps, const Compute& S, const Compute& fa, const Compute& fb, const Compute& fc, const int& bottom, Result<Real> * result ) const
+{
+	Compute c, d, e, h, fd, fe, Sleft, Sright, S2;
+
+	GEOM_COUNT( SimpsonRecursion );
 
 	c = ( a + b ) / 2.;
 	h = b - a;
 	d = ( a + c ) / 2.;
 	e = ( c + b ) / 2.;
-	fd = f( d );
-	fe = f( e );
+	fd = f( (Real)d );
+	fe = f( (Real)e );
 	Sleft = ( h / 12. ) * ( fa + 4 * fd + fc );
 	Sright = ( h / 12. ) * ( fc + 4 * fe + fb );
 	S2 = Sleft + Sright;
 
-	if ( bottom <= 0 || fabs( S2 - S ) <= 15. * eps )
+	if ( result )
+	{
+		result->evaluations += 2;
+		result->depth = std::max( result->depth, _maxRecursionDepth - bottom + 1 );
+	}
+
+	if ( bottom <= 1 || fabs( S2 - S ) <= 15. * eps )
+	{
+		if ( result )
+		{
+			result->error += fabs( S2 - S ) / 15.;
+			result->converged = result->converged && fabs( S2 - S ) <= 15. * eps;
+		}
 		return S2 + ( S2 - S ) / 15.;
+	}
 
-	return aux( f, a, c, eps / 2., Sleft, fa, fc, fd, bottom - 1 ) +
-		aux( f, c, b, eps / 2., Sright, fc, fb, fe, bottom - 1 );
+	return aux( f, a, c, eps / 2., Sleft, fa, fc, fd, bottom - 1, result ) +
+		aux( f, c, b, eps / 2., Sright, fc, fb, fe, bottom - 1, result );
 }
 
 } // namespace
@@ -28,11 +28,28 @@
 #define CURVE_SPLINE_HPP
 
 #include "Parametric.hpp"
+#include "Instrument.hpp"
 #include <vector>
+#include <utility>
+#include <cstddef>
+#include <algorithm>
 
 namespace curve
 {
 
+/**
+ * @brief Element access, bounds-checked unless NDEBUG is defined.
+ */
+template <class Type>
+inline const Type & at( const std::vector<Type> & v, std::size_t i )
+{
+#ifdef NDEBUG
+	return v[ i ];
+#else
+	return v.at( i );
+#endif
+}
+
 /**
  * @brief Spline curve base class.
  *
@@ -43,6 +60,7 @@ class Spline : public Parametric<N, Real>
 {
 public:
 	typedef geom::Vector<N, Real> Point;
+	typedef geom::WeightedPoint<N, Real> ControlPoint;
 
 	/**
 	 * @brief Constructor for uniform splines with no control points.
@@ -55,6 +73,20 @@ public:
 	 * @param points Control points.
 	 * @param degree Degree of the curve.
 	 */
+	Spline( const std::vector<ControlPoint> & points, int degree = 3 );
+
+	/**
+	 * @brief Constructor for uniform splines (control points are moved).
+	 * @param points Control points.
+	 * @param degree Degree of the curve.
+	 */
+	Spline( std::vector<ControlPoint> && points, int degree = 3 );
+
+	/**
+	 * @brief Constructor for uniform non-rational splines (weights 1).
+	 * @param points Control points.
+	 * @param degree Degree of the curve.
+	 */
 	Spline( const std::vector<Point> & points, int degree = 3 );
 
 	/**
@@ -63,6 +95,22 @@ public:
 	 * @param knots Knot vector.
 	 * @param degree Degree of the curve.
 	 */
+	Spline( const std::vector<ControlPoint> & points, const std::vector<Real> & knots, int degree = 3 );
+
+	/**
+	 * @brief Constructor for splines with custom knot vector (arrays are moved).
+	 * @param points Control points.
+	 * @param knots Knot vector.
+	 * @param degree Degree of the curve.
+	 */
+	Spline( std::vector<ControlPoint> && points, std::vector<Real> && knots, int degree = 3 );
+
+	/**
+	 * @brief Constructor for non-rational splines with custom knot vector (weights 1).
+	 * @param points Control points.
+	 * @param knots Knot vector.
+	 * @param degree Degree of the curve.
+	 */
 	Spline( const std::vector<Point> & points, const std::vector<Real> & knots, int degree = 3 );
 
 	/**
@@ -70,6 +118,14 @@ public:
 	 */
 	Spline( const Spline<N, Real> & curve );
 
+	/**
+	 * @brief Move constructor.
+	 */
+	Spline( Spline<N, Real> && curve );
+
+	Spline & operator=( const Spline<N, Real> & curve ) = default;
+	Spline & operator=( Spline<N, Real> && curve ) = default;
+
 	/**
 	 * @brief Returns the degree.
 	 */
@@ -78,7 +134,11 @@ public:
 	/**
 	 * @brief Modifies the degree.
 	 */
-	void setDegree( int n ) { _degree = n; }
+	void setDegree( int n )
+	{
+		_degree = n;
+		computeUniformKnotVector();
+	}
 
 	/**
 	 * @brief Checks if the knot vector is uniform.
@@ -88,7 +148,11 @@ public:
 	/**
 	 * @brief Makes the knot vector uniform or not.
 	 */
-	void setUniform( bool uniform ) { _uniform = uniform; }
+	void setUniform( bool uniform )
+	{
+		_uniform = uniform;
+		computeUniformKnotVector();
+	}
 
 	/**
 	 * @brief Checks if the curve is clamped.
@@ -98,43 +162,134 @@ public:
 	/**
 	 * @brief Makes the curve clamped or not.
 	 */
-	void setClamped( bool clamped ) { _clamped = clamped; }
+	void setClamped( bool clamped )
+	{
+		_clamped = clamped;
+		computeUniformKnotVector();
+	}
 
 	/**
 	 * @brief Inserts a control point before specified position.
 	 */
-	void insertControlPoint( typename std::vector<Point>::iterator position, Point point );
+	void insertControlPoint( typename std::vector<ControlPoint>::iterator position, const ControlPoint & point );
 
 	/**
 	 * @brief Appends a control point.
 	 */
-	void pushControlPoint( Point point );
+	void pushControlPoint( const ControlPoint & point );
+
+	/**
+	 * @brief Appends a control point (moved).
+	 */
+	void pushControlPoint( ControlPoint && point );
+
+	/**
+	 * @brief Appends a control point constructed in place.
+	 * @param args Arguments of a Point constructor.
+	 */
+	template <class... Args>
+	void emplaceControlPoint( Args &&... args );
+
+	/**
+	 * @brief Reserves storage for n control points (and their knots).
+	 *
+	 * Each insertion recomputes a uniform knot vector; for large arrays,
+	 * prefer to construct or setControlPoints() from a moved std::vector.
+	 */
+	void reserve( std::size_t n );
 
 	/**
 	 * @brief Removes a control point.
 	 */
-	void eraseControlPoint( typename std::vector<Point>::iterator position );
+	void eraseControlPoint( typename std::vector<ControlPoint>::iterator position );
 
 	/**
 	 * @brief Edits a control point.
 	 */
-	void replaceControlPoint( typename std::vector<Point>::iterator position, Point point );
+	void replaceControlPoint( typename std::vector<ControlPoint>::iterator position, const ControlPoint & point );
 
 	/**
 	 * @brief Returns an array of control points.
 	 */
-	const std::vector<Point>& controlPoints() const { return _controlPoints; }
+	const std::vector<ControlPoint>& controlPoints() const { return _controlPoints; }
 
 	/**
 	 * @brief Replaces the array of control points.
 	 */
-	void setControlPoints( const std::vector<Point>& controlPoints ) { _controlPoints = controlPoints; }
+	void setControlPoints( const std::vector<ControlPoint>& controlPoints )
+	{
+		_controlPoints = controlPoints;
+		computeUniformKnotVector();
+	}
+
+	/**
+	 * @brief Replaces the array of control points (moved).
+	 */
+	void setControlPoints( std::vector<ControlPoint>&& controlPoints )
+	{
+		_controlPoints = std::move( controlPoints );
+		computeUniformKnotVector();
+	}
+
+	/**
+	 * @brief Replaces the array of control points (weights 1).
+	 */
+	void setControlPoints( const std::vector<Point>& controlPoints )
+	{
+		_controlPoints = weighted( controlPoints );
+		computeUniformKnotVector();
+	}
 
 	/**
 	 * @brief Returns the knot vector.
 	 */
 	const std::vector<Real>& knotVector() const { return _knotVector; }
 
+	/**
+	 * @brief Replaces the knot vector (the curve becomes non-uniform).
+	 */
+	void setKnotVector( const std::vector<Real>& knotVector )
+	{
+		_knotVector = knotVector;
+		_uniform = false;
+		computeSpanGrid();
+	}
+
+	/**
+	 * @brief Replaces the knot vector (moved, the curve becomes non-uniform).
+	 */
+	void setKnotVector( std::vector<Real>&& knotVector )
+	{
+		_knotVector = std::move( knotVector );
+		_uniform = false;
+		computeSpanGrid();
+	}
+
+	/**
+	 * @brief Finds the knot span of u.
+	 *
+	 * Uniform knot vectors: computed in O(1).
+	 * Other knot vectors: lookup grid, then local search (binary search for
+	 * small curves).
+	 * @param u The parameter.
+	 * @return The index i such that U[i] <= u < U[i+1], p <= i <= n.
+	 * @see Algorithm A2.1, page 68, The NURBS Book (Springer 1997).
+	 */
+	int findSpan( const Real& u ) const;
+
+	/**
+	 * @brief Finds the knot span of u, starting from a known span.
+	 *
+	 * O(1) when u is in the hinted span or a neighbour (sequential sampling).
+	 * @param u The parameter.
+	 * @param hint The span of a nearby parameter.
+	 * @return The index i such that U[i] <= u < U[i+1], p <= i <= n.
+	 */
+	int findSpan( const Real& u, int hint ) const;
+
+	// Arc length between a and b.
+	using Parametric<N, Real>::length;
+
 	/**
 	 * @brief Computes the total arc length.
 	 */
@@ -147,16 +302,47 @@ public:
 	Real length() const;
 
 protected:
-	std::vector<Point> _controlPoints;
+	std::vector<ControlPoint> _controlPoints;
 	std::vector<Real> _knotVector;
 	int _degree;
 	bool _uniform;
 	bool _clamped;
+	std::vector<int> _spanGrid;  /**< Spans at regular parameters (non-uniform knots). */
+	int _spanGridPoints;         /**< Number of control points of the span grid. */
 
 	/**
 	 * @brief Computes a uniform knot vector.
 	 */
 	void computeUniformKnotVector();
+
+	/**
+	 * @brief Computes the span lookup grid of a non-uniform knot vector.
+	 */
+	void computeSpanGrid();
+
+	/**
+	 * @brief Binary search of the span of u in ]U[low], U[high][.
+	 * @see Algorithm A2.1, page 68, The NURBS Book (Springer 1997).
+	 */
+	int searchSpan( const Real& u, int low, int high ) const;
+
+	/**
+	 * @brief Moves an approximate span of u to the exact one.
+	 */
+	int adjustSpan( const Real& u, int span ) const;
+
+	/**
+	 * @brief Converts points to control points of weight 1.
+	 */
+	static std::vector<ControlPoint> weighted( const std::vector<Point>& points )
+	{
+		return std::vector<ControlPoint>( points.begin(), points.end() );
+	}
+
+	/**
+	 * @brief Minimal number of spans to use a lookup grid.
+	 */
+	enum { MinGridSpans = 16 };
 };
 
 // -----------------------------------------------------------------------------
@@ -167,68 +353,148 @@ Spline<N, Real>::Spline( int degree ) :
 	_knotVector   (),
 	_degree ( degree ),
 	_uniform( true ),
-	_clamped( true )
+	_clamped( true ),
+	_spanGrid(),
+	_spanGridPoints( 0 )
 {
 	computeUniformKnotVector();
 }
 
 template <int N, class Real>
-Spline<N, Real>::Spline( const std::vector<Point> & points, int degree ) :
+Spline<N, Real>::Spline( const std::vector<ControlPoint> & points, int degree ) :
 	_controlPoints( points ),
 	_knotVector   (),
 	_degree ( degree ),
 	_uniform( true ),
-	_clamped( true )
+	_clamped( true ),
+	_spanGrid(),
+	_spanGridPoints( 0 )
 {
 	computeUniformKnotVector();
 }
 
 template <int N, class Real>
-Spline<N, Real>::Spline( const std::vector<Point> & points, const std::vector<Real> & knots, int degree ) :
+Spline<N, Real>::Spline( std::vector<ControlPoint> && points, int degree ) :
+	_controlPoints( std::move( points ) ),
+	_knotVector   (),
+	_degree ( degree ),
+	_uniform( true ),
+	_clamped( true ),
+	_spanGrid(),
+	_spanGridPoints( 0 )
+{
+	computeUniformKnotVector();
+}
+
+template <int N, class Real>
+Spline<N, Real>::Spline( const std::vector<ControlPoint> & points, const std::vector<Real> & knots, int degree ) :
 	_controlPoints( points ),
 	_knotVector   ( knots ),
 	_degree ( degree ),
 	_uniform( false ),
-	_clamped( true )
+	_clamped( true ),
+	_spanGrid(),
+	_spanGridPoints( 0 )
 {
 	computeUniformKnotVector();
 }
 
+template <int N, class Real>
+Spline<N, Real>::Spline( std::vector<ControlPoint> && points, std::vector<Real> && knots, int degree ) :
+	_controlPoints( std::move( points ) ),
+	_knotVector   ( std::move( knots ) ),
+	_degree ( degree ),
+	_uniform( false ),
+	_clamped( true ),
+	_spanGrid(),
+	_spanGridPoints( 0 )
+{
+	computeUniformKnotVector();
+}
+
+template <int N, class Real>
+Spline<N, Real>::Spline( const std::vector<Point> & points, int degree ) :
+	Spline( weighted( points ), degree )
+{
+}
+
+template <int N, class Real>
+Spline<N, Real>::Spline( const std::vector<Point> & points, const std::vector<Real> & knots, int degree ) :
+	Spline( weighted( points ), knots, degree )
+{
+}
+
 template <int N, class Real>
 Spline<N, Real>::Spline( const Spline<N, Real> & curve ) :
 	_controlPoints( curve._controlPoints ),
 	_knotVector   ( curve._knotVector ),
 	_degree ( curve._degree ),
 	_uniform( curve._uniform ),
-	_clamped( curve._clamped )
+	_clamped( curve._clamped ),
+	_spanGrid( curve._spanGrid ),
+	_spanGridPoints( curve._spanGridPoints )
 {
 }
 
 template <int N, class Real>
-void Spline<N, Real>::insertControlPoint( typename std::vector<Point>::iterator position, Point point )
+Spline<N, Real>::Spline( Spline<N, Real> && curve ) :
+	_controlPoints( std::move( curve._controlPoints ) ),
+	_knotVector   ( std::move( curve._knotVector ) ),
+	_degree ( curve._degree ),
+	_uniform( curve._uniform ),
+	_clamped( curve._clamped ),
+	_spanGrid( std::move( curve._spanGrid ) ),
+	_spanGridPoints( curve._spanGridPoints )
+{
+}
+
+template <int N, class Real>
+void Spline<N, Real>::insertControlPoint( typename std::vector<ControlPoint>::iterator position, const ControlPoint & point )
 {
 	_controlPoints.insert( position, point );
 	computeUniformKnotVector();
 }
 
 template <int N, class Real>
-void Spline<N, Real>::pushControlPoint( Point point )
+void Spline<N, Real>::pushControlPoint( const ControlPoint & point )
 {
 	_controlPoints.push_back( point );
 	computeUniformKnotVector();
 }
 
 template <int N, class Real>
-void Spline<N, Real>::eraseControlPoint( typename std::vector<Point>::iterator position )
+void Spline<N, Real>::pushControlPoint( ControlPoint && point )
+{
+	_controlPoints.push_back( std::move( point ) );
+	computeUniformKnotVector();
+}
+
+template <int N, class Real>
+template <class... Args>
+void Spline<N, Real>::emplaceControlPoint( Args &&... args )
+{
+	_controlPoints.emplace_back( std::forward<Args>( args )... );
+	computeUniformKnotVector();
+}
+
+template <int N, class Real>
+void Spline<N, Real>::reserve( std::size_t n )
+{
+	_controlPoints.reserve( n );
+	_knotVector.reserve( n + _degree + 1 );
+}
+
+template <int N, class Real>
+void Spline<N, Real>::eraseControlPoint( typename std::vector<ControlPoint>::iterator position )
 {
 	_controlPoints.erase( position );
 	computeUniformKnotVector();
 }
 
 template <int N, class Real>
-void Spline<N, Real>::replaceControlPoint( typename std::vector<Point>::iterator position, Point point )
+void Spline<N, Real>::replaceControlPoint( typename std::vector<ControlPoint>::iterator position, const ControlPoint & point )
 {
-	_controlPoints.at( position ) = point;
+	*position = point;
 }
 
 template <int N, class Real>
@@ -253,7 +519,13 @@ void Spline<N, Real>::computeUniformKnotVector()
 	int i, n, numPoints, numKnots;
 
 	// If non-uniform, let user define its knots.
-	if ( !_uniform ) return;
+	if ( !_uniform )
+	{
+		computeSpanGrid();
+		return;
+	}
+
+	_spanGrid.clear();
 
 	numPoints = _controlPoints.size();
 	numKnots  = numPoints + _degree + 1;
@@ -273,7 +545,158 @@ void Spline<N, Real>::computeUniformKnotVector()
 	}
 }
 
+template <int N, class Real>
+int Spline<N, Real>::findSpan( const Real& u ) const
+{
+	const std::vector<Real> & U = _knotVector;
+	int n, p, span, cells;
+	Real low, high;
+
+	GEOM_COUNT( FindSpan );
+
+	p = _degree;
+	n = _controlPoints.size() - 1;
+
+	// Special case
+	if ( u <= at( U, p ) ) return p;
+	if ( u >= at( U, n+1 ) ) return n;
+
+	low = U[ p ];
+	high = U[ n+1 ];
+
+	if ( _uniform )
+	{
+		// Equally spaced knots
+		span = p + (int)( ( u - low ) / ( high - low ) * ( n + 1 - p ) );
+		return adjustSpan( u, span );
+	}
+
+	if ( !_spanGrid.empty() && _spanGridPoints == n + 1 )
+	{
+		// Span at the start of the cell of u
+		cells = _spanGrid.size();
+		span = _spanGrid[ std::min( (int)( ( u - low ) / ( high - low ) * cells ), cells - 1 ) ];
+		return adjustSpan( u, span );
+	}
+
+	return searchSpan( u, p, n + 1 );
+}
+
+template <int N, class Real>
+int Spline<N, Real>::findSpan( const Real& u, int hint ) const
+{
+	const std::vector<Real> & U = _knotVector;
+	int n, p;
+
+	p = _degree;
+	n = _controlPoints.size() - 1;
+
+	if ( hint < p || hint > n )
+		return findSpan( u );
+
+	GEOM_COUNT( FindSpan );
+
+	// Special case
+	if ( u <= at( U, p ) ) return p;
+	if ( u >= at( U, n+1 ) ) return n;
+
+	if ( u < at( U, hint ) )
+	{
+		if ( u >= U[ hint-1 ] ) return hint - 1;
+	}
+	else if ( u >= at( U, hint+1 ) )
+	{
+		if ( u < U[ hint+2 ] ) return hint + 1;
+	}
+	else
+		return hint;
+
+	return findSpan( u );
+}
+
+template <int N, class Real>
+int Spline<N, Real>::searchSpan( const Real& u, int low, int high ) const
+{
+	const std::vector<Real> & U = _knotVector;
+	int mid;
+
+	// Do binary search
+	mid = ( low + high ) / 2;
+	while ( u < at( U, mid ) || u >= at( U, mid + 1 ) )
+	{
+		if ( u < U[ mid ] )
+			high = mid;
+		else
+			low = mid;
+		mid = ( low + high ) / 2;
+	}
+	return mid;
+}
+
+template <int N, class Real>
+int Spline<N, Real>::adjustSpan( const Real& u, int span ) const
+{
+	const std::vector<Real> & U = _knotVector;
+	int n, p;
+
+	// U[p] < u < U[n+1], so both loops stop in [p, n].
+	p = _degree;
+	n = _controlPoints.size() - 1;
+	span = std::max( p, std::min( span, n ) );
+
+	while ( u < at( U, span ) ) span--;
+	while ( u >= at( U, span+1 ) ) span++;
+	return span;
+}
+
+template <int N, class Real>
+void Spline<N, Real>::computeSpanGrid()
+{
+	const std::vector<Real> & U = _knotVector;
+	int n, p, cells, c, span;
+	Real low, high, x;
+
+	p = _degree;
+	n = _controlPoints.size() - 1;
+
+	_spanGrid.clear();
+	_spanGridPoints = n + 1;
+
+	// Small or inconsistent curves use binary search.
+	cells = n + 1 - p;
+	if ( cells < MinGridSpans || (int)U.size() != n + p + 2 ) return;
+
+	low = U[ p ];
+	high = U[ n+1 ];
+	if ( !( low < high ) ) return;
+
+	_spanGrid.resize( cells );
+	span = p;
+	for ( c = 0; c < cells; c++ )
+	{
+		x = low + ( high - low ) * c / cells;
+		while ( span < n && x >= U[ span+1 ] ) span++;
+		_spanGrid[ c ] = span;
+	}
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace curve
+{
+
+extern template class Spline<2, float>;
+extern template class Spline<3, float>;
+extern template class Spline<4, float>;
+extern template class Spline<2, double>;
+extern template class Spline<3, double>;
+extern template class Spline<4, double>;
+
 } // namespace
+#endif
 
 #endif
 
@@ -0,0 +1,255 @@
+/** -*- C++ -*-
+ * @file Sweep.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef SURFACE_SWEEP_HPP
+#define SURFACE_SWEEP_HPP
+
+#include "Parametric.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Frame.hpp"
+#include "Functional.hpp"
+#include <memory>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+namespace surface
+{
+
+/**
+ * @brief Sweep surface class template.
+ *
+ * A class template for generalized sweeps: a 2D profile curve is moved along
+ * an axial curve, oriented by a frame and scaled by a radius function.
+ *
+ * S(t,u) = C(t) + r * s(t) * ( N(t) * P(u).x + B(t) * P(u).y )
+ */
+template <class Real = float>
+class Sweep : public geom::BinaryFunction<Real, Real, geom::Vector<3, Real> >
+{
+public:
+	typedef geom::Vector<3, Real> Point;
+	typedef geom::Vector<2, Real> ProfilePoint;
+
+	typedef std::shared_ptr<const frame::Curve<3, Real> > FramePointer;
+	typedef std::shared_ptr<const curve::Parametric<2, Real> > ProfilePointer;
+	typedef std::shared_ptr<const curve::Parametric<1, Real> > ScalePointer;
+
+	/**
+	 * @brief Constructor from a curve and a profile.
+	 *
+	 * Curve objects are copied once; std::shared_ptr are shared without copy.
+	 * Only enabled for frame types (derived from frame::Curve).
+	 * @param curve The axial curve.
+	 * @param profile The cross-section curve (2D).
+	 * @param radius Constant scale factor of the section.
+	 */
+	template <class CurveType, class FrameType, class ProfileType,
+		class = typename std::enable_if<std::is_base_of<frame::Curve<3, Real>, FrameType>::value>::type>
+	Sweep( const CurveType& curve, const FrameType&, const ProfileType& profile, Real radius = 1. ) :
+		_frame  ( std::make_shared<const FrameType>( curve::share( curve ) ) ),
+		_profile( curve::share( profile ) ),
+		_scale  (),
+		_radius ( radius )
+	{
+	}
+
+	/**
+	 * @brief Constructor from a curve, a profile and a scale function.
+	 *
+	 * Only enabled for frame types and non-arithmetic scales, so that
+	 * Sweep( curve, frame, profile, radius ) never binds the radius as a
+	 * scale function.
+	 * @param curve The axial curve.
+	 * @param profile The cross-section curve (2D).
+	 * @param scale The scale function along the curve (1D curve).
+	 * @param radius Constant scale factor of the section.
+	 */
+	template <class CurveType, class FrameType, class ProfileType, class ScaleType,
+		class = typename std::enable_if<std::is_base_of<frame::Curve<3, Real>, FrameType>::value &&
+			!std::is_arithmetic<ScaleType>::value>::type>
+	Sweep( const CurveType& curve, const FrameType&, const ProfileType& profile, const ScaleType& scale, Real radius = 1. ) :
+		_frame  ( std::make_shared<const FrameType>( curve::share( curve ) ) ),
+		_profile( curve::share( profile ) ),
+		_scale  ( curve::share( scale ) ),
+		_radius ( radius )
+	{
+	}
+
+	inline const typename frame::Curve<3, Real>::CurvePointer & getCurve() const { return _frame->getCurve(); }
+	inline const FramePointer & getFrame() const { return _frame; }
+	inline const ProfilePointer & getProfile() const { return _profile; }
+	inline const ScalePointer & getScale() const { return _scale; }
+	inline Real getRadius() const { return _radius; }
+
+	/**
+	 * @param radius The new radius.
+	 */
+	void setRadius( const Real& radius )
+	{
+		_radius = radius;
+	}
+
+	/**
+	 * @brief Computes the scale factor of the section at t.
+	 * @param t The parameter t along the curve.
+	 * @return r * s(t), or r if there is no scale function.
+	 */
+	inline Real scale( const Real& t ) const
+	{
+		return _scale ? _radius * (*_scale)( t )[ 0 ] : _radius;
+	}
+
+	/**
+	 * @brief Computes S(t,u).
+	 * @param t The parameter t along the curve.
+	 * @param u The parameter u along the profile.
+	 * @return The computed point.
+	 */
+	Point operator() ( const Real& t, const Real& u ) const
+	{
+		return (*getCurve())( t ) + section( t ) * (*_profile)( u );
+	}
+
+	/**
+	 * @brief Computes the section transform at t.
+	 *
+	 * The 3x2 matrix maps a profile point into the plane of the section,
+	 * scaled by scale( t ).
+	 * @param t The parameter t along the curve.
+	 * @return The matrix ( r * s(t) * N(t), r * s(t) * B(t) ).
+	 */
+	geom::Matrix<3, 2, Real> section( const Real& t ) const;
+
+	/**
+	 * @brief Computes a grid of nt x nu points.
+	 *
+	 * The profile is evaluated once; each ring only costs one frame
+	 * evaluation and nu matrix products.
+	 * @param t0 First parameter along the curve.
+	 * @param t1 Last parameter along the curve.
+	 * @param nt Number of rings (at least 2).
+	 * @param u0 First parameter along the profile.
+	 * @param u1 Last parameter along the profile.
+	 * @param nu Number of points per ring (at least 2).
+	 * @param points Output array, ring after ring (nt * nu points).
+	 * @throw std::invalid_argument If nt < 2 or nu < 2.
+	 */
+	void tessellate( const Real& t0, const Real& t1, int nt, const Real& u0, const Real& u1, int nu, std::vector<Point>& points ) const;
+
+	/**
+	 * @brief Computes a grid of rings with a precomputed profile.
+	 * @param t0 First parameter along the curve.
+	 * @param t1 Last parameter along the curve.
+	 * @param nt Number of rings (at least 2).
+	 * @param profile Profile points (2D), shared by every ring.
+	 * @param points Output array, ring after ring (nt * profile.size() points).
+	 * @throw std::invalid_argument If nt < 2.
+	 */
+	void tessellate( const Real& t0, const Real& t1, int nt, const std::vector<ProfilePoint>& profile, std::vector<Point>& points ) const;
+
+protected:
+	FramePointer _frame;
+	ProfilePointer _profile;
+	ScalePointer _scale;
+	Real _radius;
+};
+
+// -----------------------------------------------------------------------------
+
+template <class Real>
+geom::Matrix<3, 2, Real> Sweep<Real>::section( const Real& t ) const
+{
+	geom::Matrix<3, 3, Real> mTNB;
+	geom::Matrix<3, 2, Real> m;
+	Real s;
+
+	mTNB = (*_frame)( t );
+	s = scale( t );
+
+	m.setColumn( 0, mTNB.column( 1 ) * s );
+	m.setColumn( 1, mTNB.column( 2 ) * s );
+	return m;
+}
+
+template <class Real>
+void Sweep<Real>::tessellate( const Real& t0, const Real& t1, int nt, const Real& u0, const Real& u1, int nu, std::vector<Point>& points ) const
+{
+	std::vector<ProfilePoint> profile;
+	int j;
+
+	if ( nu < 2 )
+		throw std::invalid_argument( "surface::Sweep: at least 2 points per ring" );
+
+	profile.resize( nu );
+	for ( j = 0; j < nu; j++ )
+		profile[ j ] = (*_profile)( u0 + ( u1 - u0 ) * j / (Real)( nu - 1 ) );
+
+	tessellate( t0, t1, nt, profile, points );
+}
+
+template <class Real>
+void Sweep<Real>::tessellate( const Real& t0, const Real& t1, int nt, const std::vector<ProfilePoint>& profile, std::vector<Point>& points ) const
+{
+	geom::Matrix<3, 2, Real> m;
+	Point c;
+	Real t;
+	int i, j, nu;
+
+	if ( nt < 2 )
+		throw std::invalid_argument( "surface::Sweep: at least 2 rings" );
+
+	nu = profile.size();
+	points.resize( nt * nu );
+
+	for ( i = 0; i < nt; i++ )
+	{
+		t = t0 + ( t1 - t0 ) * i / (Real)( nt - 1 );
+		c = (*getCurve())( t );
+		m = section( t );
+
+		for ( j = 0; j < nu; j++ )
+			points[ i * nu + j ] = c + m * profile[ j ];
+	}
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace surface
+{
+
+extern template class Sweep<float>;
+extern template class Sweep<double>;
+
+} // namespace
+#endif
+
+#endif
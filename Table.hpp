@@ -0,0 +1,198 @@
+/** -*- C++ -*-
+ * @file Table.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef FRAME_TABLE_HPP
+#define FRAME_TABLE_HPP
+
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Frame.hpp"
+#include <vector>
+#include <stdexcept>
+
+namespace frame
+{
+
+/**
+ * @brief Frame table class template.
+ *
+ * A class to cache the frames of a curve: any frame generator is sampled
+ * once at uniform parameters, and the frames are stored as unit
+ * quaternions (4 reals instead of 9). Queries interpolate between the two
+ * closest samples, without evaluating the curve.
+ *
+ * The error decreases as the square of the sample spacing for smooth
+ * frames; the Frenet frame of a cubic curve has kinks at the knots, where
+ * it only decreases linearly.
+ */
+template <class Real = float>
+class Table : public Curve<3, Real>
+{
+public:
+	typedef geom::Quaternion<Real> Rotation;
+
+	/**
+	 * @brief Interpolation between samples.
+	 */
+	enum Interpolation
+	{
+		Nlerp, /**< Normalized linear (cheapest). */
+		Slerp  /**< Spherical linear (constant angular speed). */
+	};
+
+	/**
+	 * @brief Empty constructor.
+	 */
+	Table() :
+		Curve<3, Real>(),
+		_t0( 0 ),
+		_scale( 0 ),
+		_interpolation( Nlerp )
+	{
+	}
+
+	/**
+	 * @brief Constructor from a frame generator.
+	 *
+	 * The table shares the curve of the generator.
+	 * @param frame The frame generator (e.g. Frenet), with a curve.
+	 * @param t0 First parameter.
+	 * @param t1 Last parameter.
+	 * @param count Number of samples (at least 2).
+	 * @param interpolation Interpolation between samples.
+	 * @throw std::invalid_argument If count < 2 or t0 == t1.
+	 */
+	template <class FrameType>
+	Table( const FrameType & frame, const Real & t0, const Real & t1, int count, Interpolation interpolation = Nlerp ) :
+		Curve<3, Real>( frame.getCurve() ),
+		_interpolation( interpolation )
+	{
+		build( frame, t0, t1, count );
+	}
+
+	/**
+	 * @brief Samples a frame generator (the curve is unchanged).
+	 */
+	template <class FrameType>
+	void build( const FrameType & frame, const Real & t0, const Real & t1, int count );
+
+	inline int size() const { return (int)_samples.size(); }
+	inline Real first() const { return _t0; }
+	inline Real last() const { return _t0 + ( size() - 1 ) / _scale; }
+	inline const std::vector<Rotation> & samples() const { return _samples; }
+
+	inline Interpolation getInterpolation() const { return _interpolation; }
+	inline void setInterpolation( Interpolation interpolation ) { _interpolation = interpolation; }
+
+	/**
+	 * @brief Computes the interpolated rotation.
+	 * @param t The parameter t along the curve (clamped to the table).
+	 */
+	Rotation rotation( const Real & t ) const;
+
+	/**
+	 * @brief Computes the frame.
+	 * @param t The parameter t along the curve (clamped to the table).
+	 * @return The interpolated frame (Matrix 3x3, columns are T, N, B).
+	 */
+	geom::Matrix<3, 3, Real> operator() ( const Real & t ) const
+	{
+		return rotation( t ).matrix();
+	}
+
+private:
+	std::vector<Rotation> _samples;
+	Real _t0;
+	Real _scale; /**< Samples per unit of t. */
+	Interpolation _interpolation;
+};
+
+// -----------------------------------------------------------------------------
+
+template <class Real>
+template <class FrameType>
+void Table<Real>::build( const FrameType & frame, const Real & t0, const Real & t1, int count )
+{
+	int i;
+
+	if ( count < 2 || t0 == t1 )
+		throw std::invalid_argument( "frame::Table: at least 2 samples over a non-empty interval" );
+
+	_t0 = t0;
+	_scale = ( count - 1 ) / ( t1 - t0 );
+	_samples.resize( count );
+
+	for ( i = 0; i < count; i++ )
+	{
+		_samples[ i ] = Rotation( frame( t0 + ( t1 - t0 ) * i / (Real)( count - 1 ) ) );
+
+		// Same hemisphere as the previous sample: interpolation can skip the sign test
+		if ( i > 0 && _samples[ i ].dot( _samples[ i - 1 ] ) < 0 )
+			_samples[ i ] = -_samples[ i ];
+	}
+}
+
+template <class Real>
+typename Table<Real>::Rotation Table<Real>::rotation( const Real & t ) const
+{
+	Real u, f;
+	int i, n;
+
+	n = size();
+	if ( n == 0 )
+		return Rotation();
+
+	u = ( t - _t0 ) * _scale;
+	if ( !( u > 0 ) )
+		return _samples[ 0 ];
+	if ( u >= n - 1 )
+		return _samples[ n - 1 ];
+
+	i = (int)u;
+	f = u - i;
+
+	if ( _interpolation == Slerp )
+		return geom::slerp( _samples[ i ], _samples[ i + 1 ], f );
+	return geom::nlerp( _samples[ i ], _samples[ i + 1 ], f );
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace frame
+{
+
+extern template class Table<float>;
+extern template class Table<double>;
+
+} // namespace
+#endif
+
+#endif
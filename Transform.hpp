@@ -0,0 +1,284 @@
+/** -*- C++ -*-
+ * @file Transform.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef GEOM_TRANSFORM_HPP
+#define GEOM_TRANSFORM_HPP
+
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Dispatch.hpp"
+#include "Parallel.hpp"
+#include <cstddef>
+#include <algorithm>
+
+namespace geom
+{
+
+/**
+ * @brief Applies a matrix to an array of vectors: out[i] = m * in[i].
+ * @param m The matrix.
+ * @param in The vectors.
+ * @param out Output vectors (may be in, when M = N).
+ * @param count Number of vectors.
+ * @param threads Number of threads (0 = hardware threads).
+ */
+template <int M, int N, class Real>
+void transform( const Matrix<M, N, Real> & m, const Vector<N, Real> * in, Vector<M, Real> * out, std::size_t count, unsigned threads = 1 );
+
+/**
+ * @brief Applies one matrix per vector: out[i] = m[i] * in[i].
+ *
+ * Typically rotates local offsets by the frames of a curve.
+ * @param m The matrices (count matrices).
+ * @param in The vectors.
+ * @param out Output vectors (may be in, when M = N).
+ * @param count Number of vectors.
+ * @param threads Number of threads (0 = hardware threads).
+ */
+template <int M, int N, class Real>
+void transform( const Matrix<M, N, Real> * m, const Vector<N, Real> * in, Vector<M, Real> * out, std::size_t count, unsigned threads = 1 );
+
+/**
+ * @brief Applies an affine transform to an array of points.
+ *
+ * out[i] = A * in[i] + b, with A the upper left N x N block of m and b
+ * the first N rows of its last column; the last row of m is ignored
+ * (assumed to be 0 ... 0 1).
+ * @param m The homogeneous matrix.
+ * @param in The points.
+ * @param out Output points (may be in).
+ * @param count Number of points.
+ * @param threads Number of threads (0 = hardware threads).
+ */
+template <int N, class Real>
+void transformPoints( const Matrix<N + 1, N + 1, Real> & m, const Vector<N, Real> * in, Vector<N, Real> * out, std::size_t count, unsigned threads = 1 );
+
+/**
+ * @brief Batched kernels of the transforms.
+ *
+ * Coefficients are copied to local arrays, so that the compiler keeps them
+ * in registers and vectorizes across vectors. The arrays are split into
+ * blocks of Block vectors, handed out to the threads; every block runs
+ * the variant of the active instruction set (see geom::cpu::isa).
+ */
+template <int M, int N, class Real>
+struct Batch
+{
+	enum { Block = 4096 };
+
+	typedef Vector<M, Real> Output;
+	typedef Vector<N, Real> Input;
+
+	/**
+	 * @brief Computes out[i] = a * in[i] + b for i in [first, last).
+	 */
+	template <bool Affine>
+	static inline void apply( const Real ( &m )[ M ][ N + 1 ], const Input * in, Output * out, std::size_t first, std::size_t last )
+	{
+		Real a[ M ][ N + 1 ], x[ N ], y;
+		std::size_t i;
+		int r, c;
+
+		for ( r = 0; r < M; r++ )
+		{
+			for ( c = 0; c <= N; c++ )
+				a[ r ][ c ] = m[ r ][ c ];
+		}
+
+		for ( i = first; i < last; i++ )
+		{
+			for ( c = 0; c < N; c++ )
+				x[ c ] = in[ i ][ c ];
+			for ( r = 0; r < M; r++ )
+			{
+				y = ( Affine ? a[ r ][ N ] : a[ r ][ 0 ] * x[ 0 ] );
+				for ( c = ( Affine ? 0 : 1 ); c < N; c++ )
+					y += a[ r ][ c ] * x[ c ];
+				out[ i ][ r ] = y;
+			}
+		}
+	}
+
+	/**
+	 * @brief Computes out[i] = m[i] * in[i] for i in [first, last).
+	 */
+	static inline void each( const Matrix<M, N, Real> * m, const Input * in, Output * out, std::size_t first, std::size_t last )
+	{
+		Real x[ N ], y;
+		std::size_t i;
+		int r, c;
+
+		for ( i = first; i < last; i++ )
+		{
+			for ( c = 0; c < N; c++ )
+				x[ c ] = in[ i ][ c ];
+			for ( r = 0; r < M; r++ )
+			{
+				y = m[ i ][ r ][ 0 ] * x[ 0 ];
+				for ( c = 1; c < N; c++ )
+					y += m[ i ][ r ][ c ] * x[ c ];
+				out[ i ][ r ] = y;
+			}
+		}
+	}
+
+	template <bool Affine>
+	GEOM_TARGET( "avx2,fma" )
+	static void applyAVX2( const Real ( &m )[ M ][ N + 1 ], const Input * in, Output * out, std::size_t first, std::size_t last )
+	{
+		apply<Affine>( m, in, out, first, last );
+	}
+
+	template <bool Affine>
+	GEOM_TARGET( "avx512f,avx512vl,avx512bw,avx512dq" )
+	static void applyAVX512( const Real ( &m )[ M ][ N + 1 ], const Input * in, Output * out, std::size_t first, std::size_t last )
+	{
+		apply<Affine>( m, in, out, first, last );
+	}
+
+	GEOM_TARGET( "avx2,fma" )
+	static void eachAVX2( const Matrix<M, N, Real> * m, const Input * in, Output * out, std::size_t first, std::size_t last )
+	{
+		each( m, in, out, first, last );
+	}
+
+	GEOM_TARGET( "avx512f,avx512vl,avx512bw,avx512dq" )
+	static void eachAVX512( const Matrix<M, N, Real> * m, const Input * in, Output * out, std::size_t first, std::size_t last )
+	{
+		each( m, in, out, first, last );
+	}
+
+	/**
+	 * @brief Runs apply on every block, with the active instruction set.
+	 * @param m Coefficients: a in the first N columns, b in the last one.
+	 */
+	template <bool Affine>
+	static void run( const Real ( &m )[ M ][ N + 1 ], const Input * in, Output * out, std::size_t count, unsigned threads );
+
+	/**
+	 * @brief Runs each on every block, with the active instruction set.
+	 */
+	static void run( const Matrix<M, N, Real> * m, const Input * in, Output * out, std::size_t count, unsigned threads );
+};
+
+// -----------------------------------------------------------------------------
+
+template <int M, int N, class Real>
+template <bool Affine>
+void Batch<M, N, Real>::run( const Real ( &m )[ M ][ N + 1 ], const Input * in, Output * out, std::size_t count, unsigned threads )
+{
+	const geom::cpu::Isa isa = geom::cpu::isa();
+
+	geom::parallelFor( ( count + Block - 1 ) / Block, threads, [ & ]( std::size_t b, unsigned )
+	{
+		std::size_t first = b * Block, last = std::min( first + Block, count );
+
+		switch ( isa )
+		{
+#ifdef GEOM_HAVE_DISPATCH
+		case geom::cpu::AVX512: applyAVX512<Affine>( m, in, out, first, last ); break;
+		case geom::cpu::AVX2:   applyAVX2<Affine>( m, in, out, first, last ); break;
+#endif
+		default:                apply<Affine>( m, in, out, first, last ); break;
+		}
+	}, 1 );
+}
+
+template <int M, int N, class Real>
+void Batch<M, N, Real>::run( const Matrix<M, N, Real> * m, const Input * in, Output * out, std::size_t count, unsigned threads )
+{
+	const geom::cpu::Isa isa = geom::cpu::isa();
+
+	geom::parallelFor( ( count + Block - 1 ) / Block, threads, [ & ]( std::size_t b, unsigned )
+	{
+		std::size_t first = b * Block, last = std::min( first + Block, count );
+
+		switch ( isa )
+		{
+#ifdef GEOM_HAVE_DISPATCH
+		case geom::cpu::AVX512: eachAVX512( m, in, out, first, last ); break;
+		case geom::cpu::AVX2:   eachAVX2( m, in, out, first, last ); break;
+#endif
+		default:                each( m, in, out, first, last ); break;
+		}
+	}, 1 );
+}
+
+template <int M, int N, class Real>
+void transform( const Matrix<M, N, Real> & m, const Vector<N, Real> * in, Vector<M, Real> * out, std::size_t count, unsigned threads )
+{
+	Real a[ M ][ N + 1 ];
+	int r, c;
+
+	for ( r = 0; r < M; r++ )
+	{
+		for ( c = 0; c < N; c++ )
+			a[ r ][ c ] = m[ r ][ c ];
+		a[ r ][ N ] = 0;
+	}
+	Batch<M, N, Real>::template run<false>( a, in, out, count, threads );
+}
+
+template <int M, int N, class Real>
+void transform( const Matrix<M, N, Real> * m, const Vector<N, Real> * in, Vector<M, Real> * out, std::size_t count, unsigned threads )
+{
+	Batch<M, N, Real>::run( m, in, out, count, threads );
+}
+
+template <int N, class Real>
+void transformPoints( const Matrix<N + 1, N + 1, Real> & m, const Vector<N, Real> * in, Vector<N, Real> * out, std::size_t count, unsigned threads )
+{
+	Real a[ N ][ N + 1 ];
+	int r, c;
+
+	for ( r = 0; r < N; r++ )
+	{
+		for ( c = 0; c <= N; c++ )
+			a[ r ][ c ] = m[ r ][ c ];
+	}
+	Batch<N, N, Real>::template run<true>( a, in, out, count, threads );
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace geom
+{
+
+extern template struct Batch<2, 2, float>;
+extern template struct Batch<3, 3, float>;
+extern template struct Batch<4, 4, float>;
+extern template struct Batch<2, 2, double>;
+extern template struct Batch<3, 3, double>;
+extern template struct Batch<4, 4, double>;
+
+} // namespace
+#endif
+
+#endif
@@ -30,43 +30,178 @@
 #include "Parametric.hpp"
 #include "Vector.hpp"
 #include "Frame.hpp"
-#include <functional>
+#include "Frenet.hpp"
+#include "Instrument.hpp"
+#include "Functional.hpp"
+#include <memory>
+#include <vector>
 #include <cmath>
+#include <stdexcept>
+#include <type_traits>
 
 namespace surface
 {
 
+/**
+ * @brief Computes a point of a tube.
+ *
+ * The curve is evaluated with curve::Static<CurveType>.
+ * @param curve The axial curve.
+ * @param frame The frame generator along the curve.
+ * @param radius Radius of the tube.
+ * @param t The parameter t along the curve.
+ * @param u The angle u along the ring, 0 <= u <= 2*pi.
+ * @return The computed point.
+ */
+template <class CurveType, class FrameType>
+inline geom::Vector<3, typename CurveType::Type> tube( const CurveType& curve, const FrameType& frame, const typename CurveType::Type& radius, const typename CurveType::Type& t, const typename CurveType::Type& u )
+{
+	typedef typename CurveType::Type Real;
+
+	geom::Matrix<3, 3, Real> mTNB;
+
+	GEOM_SCOPE( Tube );
+
+	mTNB = frame( t );
+
+	geom::Vector<3, Real> vP( curve::Static<CurveType>::point( curve, t ) );
+	geom::Vector<3, Real> vN( mTNB.column( 1 ) );
+	geom::Vector<3, Real> vB( mTNB.column( 2 ) );
+
+	return vP + vN * radius * cos( u ) + vB * radius * sin( u );
+}
+
+/**
+ * @brief Unit circle template of the rings of a tube.
+ *
+ * Holds cos( u ) and sin( u ) at the angles of a ring, computed once and
+ * shared by every ring of a tessellation.
+ */
+template <class Real = float>
+class Ring
+{
+public:
+	typedef geom::Vector<3, Real> Point;
+
+	/**
+	 * @brief Full circle of n points, at u = 2 pi j / n.
+	 */
+	explicit Ring( int n = 16 ) { setResolution( n ); }
+
+	/**
+	 * @brief Ring at arbitrary angles.
+	 */
+	explicit Ring( const std::vector<Real>& angles ) { setAngles( angles ); }
+
+	/**
+	 * @brief Makes a full circle of n points, at u = 2 pi j / n.
+	 */
+	void setResolution( int n );
+
+	/**
+	 * @brief Makes a ring at arbitrary angles.
+	 */
+	void setAngles( const std::vector<Real>& angles );
+
+	inline int size() const                        { return _cos.size(); }
+	inline const std::vector<Real>& cosines() const { return _cos; }
+	inline const std::vector<Real>& sines() const   { return _sin; }
+
+	/**
+	 * @brief Emits a ring: out[ j ] = P + N r cos( u_j ) + B r sin( u_j ).
+	 * @param P Center of the ring.
+	 * @param N Normal of the frame.
+	 * @param B Binormal of the frame.
+	 * @param radius Radius of the ring.
+	 * @param out Output array of size() points.
+	 */
+	void transform( const Point& P, const Point& N, const Point& B, const Real& radius, Point * out ) const;
+
+private:
+	std::vector<Real> _cos;
+	std::vector<Real> _sin;
+};
+
+/**
+ * @brief Computes a ring of a tube.
+ *
+ * One curve and one frame evaluation for the whole ring.
+ * @param curve The axial curve.
+ * @param frame The frame generator along the curve.
+ * @param radius Radius of the tube.
+ * @param t The parameter t along the curve.
+ * @param ring The unit circle template.
+ * @param out Output array of ring.size() points.
+ */
+template <class CurveType, class FrameType>
+inline void ring( const CurveType& curve, const FrameType& frame, const typename CurveType::Type& radius, const typename CurveType::Type& t, const Ring<typename CurveType::Type>& ring, geom::Vector<3, typename CurveType::Type> * out )
+{
+	typedef typename CurveType::Type Real;
+
+	geom::Matrix<3, 3, Real> mTNB;
+
+	GEOM_SCOPE( TubeRing );
+
+	mTNB = frame( t );
+	ring.transform( curve::Static<CurveType>::point( curve, t ), mTNB.column( 1 ), mTNB.column( 2 ), radius, out );
+}
+
+/**
+ * @brief Computes a grid of rings of a tube (Tube or StaticTube).
+ * @param tube The tube.
+ * @param t0 First parameter along the curve.
+ * @param t1 Last parameter along the curve.
+ * @param nt Number of rings (at least 2).
+ * @param ring The unit circle template.
+ * @param points Output array, ring after ring (nt * ring.size() points).
+ * @throw std::invalid_argument If nt < 2.
+ */
+template <class TubeType>
+void tessellate( const TubeType& tube, const typename TubeType::Type& t0, const typename TubeType::Type& t1, int nt, const Ring<typename TubeType::Type>& ring, std::vector<geom::Vector<3, typename TubeType::Type> >& points );
+
 /**
  * @brief Tube surface class template.
  *
  * A class template for tube.
  */
 template <class Real = float>
-class Tube : public std::binary_function<Real, Real, geom::Vector<3, Real> >
+class Tube : public geom::BinaryFunction<Real, Real, geom::Vector<3, Real> >
 {
 public:
+	typedef Real Type;
+	typedef std::shared_ptr<const frame::Curve<3, Real> > FramePointer;
+
 	/**
 	 * @brief Constructor from a curve.
+	 *
+	 * A curve object is copied once; a std::shared_ptr is shared without copy.
+	 * Only enabled for frame types (derived from frame::Curve), so that
+	 * Tube( frame, radius ) never binds the radius as a frame.
 	 * @param curve The axial curve.
 	 * @param radius Radius of the tube.
 	 */
-	template <class CurveType, class FrameType>
+	template <class CurveType, class FrameType,
+		class = typename std::enable_if<std::is_base_of<frame::Curve<3, Real>, FrameType>::value>::type>
 	Tube( const CurveType& curve, const FrameType&, Real radius = 1. ) :
-		_frame ( new FrameType( curve ) ),
+		_frame ( std::make_shared<const FrameType>( curve::share( curve ) ) ),
 		_radius( radius )
 	{
 	}
 
 	/**
-	 * @brief Deletes the allocated frame.
+	 * @brief Constructor from a shared frame.
+	 * @param frame The frame (and its axial curve), shared without copy.
+	 * @param radius Radius of the tube.
 	 */
-	~Tube()
+	template <class FrameType>
+	Tube( const std::shared_ptr<FrameType>& frame, Real radius = 1. ) :
+		_frame ( frame ),
+		_radius( radius )
 	{
-		delete _frame;
 	}
 
-	inline const curve::Parametric<3, Real> * getCurve() const { return _frame->getCurve(); }
-	inline const frame::Curve<3, Real> * getFrame() const { return _frame; }
+	inline const typename frame::Curve<3, Real>::CurvePointer & getCurve() const { return _frame->getCurve(); }
+	inline const FramePointer & getFrame() const { return _frame; }
 	inline Real getRadius() const { return _radius; }
 
 	/**
@@ -85,22 +220,251 @@ public:
 	 */
 	geom::Vector<3, Real> operator() ( const Real& t, const Real& u ) const
 	{
-		geom::Matrix<3, 3, Real> mTNB;
+		return tube( *getCurve(), *_frame, _radius, t, u );
+	}
 
-		mTNB = (*_frame)( t );
+	/**
+	 * @brief Computes the ring at t.
+	 * @param t The parameter t along the curve, t0 <= t <= tn.
+	 * @param ring The unit circle template.
+	 * @param out Output array of ring.size() points.
+	 */
+	void ring( const Real& t, const Ring<Real>& ring, geom::Vector<3, Real> * out ) const
+	{
+		surface::ring( *getCurve(), *_frame, _radius, t, ring, out );
+	}
 
-		geom::Vector<3, Real> vP( (*_frame->getCurve())( t ) );
-		geom::Vector<3, Real> vN( mTNB[ 1 ] );
-		geom::Vector<3, Real> vB( mTNB[ 2 ] );
+	/**
+	 * @brief Computes a grid of nt rings.
+	 * @param t0 First parameter along the curve.
+	 * @param t1 Last parameter along the curve.
+	 * @param nt Number of rings (at least 2).
+	 * @param ring The unit circle template.
+	 * @param points Output array, ring after ring (nt * ring.size() points).
+	 */
+	void tessellate( const Real& t0, const Real& t1, int nt, const Ring<Real>& ring, std::vector<geom::Vector<3, Real> >& points ) const
+	{
+		surface::tessellate( *this, t0, t1, nt, ring, points );
+	}
 
-		return vP + vN * _radius * cos( u ) + vB * _radius * sin( u );
+protected:
+	FramePointer _frame;
+	Real _radius;
+};
+
+/**
+ * @brief Statically dispatched tube surface class template.
+ *
+ * Same surface as Tube, but bound to concrete curve and frame types so that
+ * the whole evaluation can be inlined.
+ */
+template <class CurveType, class FrameType = frame::StaticFrenet<CurveType> >
+class StaticTube : public geom::BinaryFunction<typename CurveType::Type, typename CurveType::Type, geom::Vector<3, typename CurveType::Type> >
+{
+public:
+	typedef typename CurveType::Type Real;
+	typedef Real Type;
+
+	/**
+	 * @brief Constructor from a curve (copied once, or shared).
+	 * @param curve The axial curve, of type CurveType (not a derived type).
+	 * @param radius Radius of the tube.
+	 */
+	template <class Type>
+	StaticTube( const Type& curve, Real radius = 1. ) :
+		_frame ( curve::share( curve ) ),
+		_radius( radius )
+	{
+		static_assert( std::is_same<typename curve::Shared<Type>::Object, CurveType>::value,
+			"surface::StaticTube: the curve must be a CurveType" );
+	}
+
+	inline const std::shared_ptr<const CurveType> & getCurve() const { return _frame.getCurve(); }
+	inline const FrameType & getFrame() const { return _frame; }
+	inline Real getRadius() const { return _radius; }
+
+	/**
+	 * @param radius The new radius.
+	 */
+	void setRadius( const Real& radius )
+	{
+		_radius = radius;
+	}
+
+	/**
+	 * @brief Computes S(t,u).
+	 * @param t The parameter t along the curve, t0 <= t <= tn.
+	 * @param u The angle u along the ring, 0 <= u <= 2*pi.
+	 * @return The computed point.
+	 */
+	inline geom::Vector<3, Real> operator() ( const Real& t, const Real& u ) const
+	{
+		return tube( *getCurve(), _frame, _radius, t, u );
+	}
+
+	/**
+	 * @brief Computes the ring at t (see Tube::ring).
+	 */
+	inline void ring( const Real& t, const Ring<Real>& ring, geom::Vector<3, Real> * out ) const
+	{
+		surface::ring( *getCurve(), _frame, _radius, t, ring, out );
+	}
+
+	/**
+	 * @brief Computes a grid of nt rings (see Tube::tessellate).
+	 */
+	void tessellate( const Real& t0, const Real& t1, int nt, const Ring<Real>& ring, std::vector<geom::Vector<3, Real> >& points ) const
+	{
+		surface::tessellate( *this, t0, t1, nt, ring, points );
 	}
 
 protected:
-	const frame::Curve<3, Real> * _frame;
+	FrameType _frame;
 	Real _radius;
 };
 
+/**
+ * @brief Streaming ring generator.
+ *
+ * Emits the rings of a tube one at a time into a caller buffer, so that
+ * long tubes are tessellated with the memory of a single ring.
+ */
+template <class TubeType>
+class RingGenerator
+{
+public:
+	typedef typename TubeType::Type Real;
+	typedef geom::Vector<3, Real> Point;
+
+	/**
+	 * @param tube The tube (not copied, must outlive the generator).
+	 * @param ring The unit circle template.
+	 * @param t0 First parameter along the curve.
+	 * @param t1 Last parameter along the curve.
+	 * @param count Number of rings (at least 2).
+	 * @throw std::invalid_argument If count < 2.
+	 */
+	RingGenerator( const TubeType& tube, const Ring<Real>& ring, const Real& t0, const Real& t1, int count ) :
+		_tube( &tube ), _ring( ring ), _t0( t0 ), _t1( t1 ), _count( count ), _index( 0 )
+	{
+		if ( count < 2 )
+			throw std::invalid_argument( "surface::RingGenerator: at least 2 rings" );
+	}
+
+	/**
+	 * @brief Emits the next ring.
+	 * @param out Output array of ringSize() points.
+	 * @return False (and nothing written) once every ring is emitted.
+	 */
+	bool next( Point * out )
+	{
+		if ( _index >= _count )
+			return false;
+		_tube->ring( parameter( _index ), _ring, out );
+		_index++;
+		return true;
+	}
+
+	/**
+	 * @brief Returns the parameter of ring i.
+	 */
+	inline Real parameter( int i ) const { return _t0 + ( _t1 - _t0 ) * i / (Real)( _count - 1 ); }
+
+	inline void reset()                   { _index = 0; }
+	inline int index() const              { return _index; }
+	inline int count() const              { return _count; }
+	inline int ringSize() const           { return _ring.size(); }
+	inline const Ring<Real>& ring() const { return _ring; }
+
+private:
+	const TubeType * _tube;
+	Ring<Real> _ring;
+	Real _t0, _t1;
+	int _count;
+	int _index;
+};
+
+// -----------------------------------------------------------------------------
+
+template <class Real>
+void Ring<Real>::setResolution( int n )
+{
+	const double pi = 3.14159265358979323846;
+	double u;
+	int j;
+
+	_cos.resize( n );
+	_sin.resize( n );
+	for ( j = 0; j < n; j++ )
+	{
+		u = 2 * pi * j / n;
+		_cos[ j ] = cos( u );
+		_sin[ j ] = sin( u );
+	}
+}
+
+template <class Real>
+void Ring<Real>::setAngles( const std::vector<Real>& angles )
+{
+	std::size_t j;
+
+	_cos.resize( angles.size() );
+	_sin.resize( angles.size() );
+	for ( j = 0; j < angles.size(); j++ )
+	{
+		_cos[ j ] = cos( angles[ j ] );
+		_sin[ j ] = sin( angles[ j ] );
+	}
+}
+
+template <class Real>
+void Ring<Real>::transform( const Point& P, const Point& N, const Point& B, const Real& radius, Point * out ) const
+{
+	Real Nr[ 3 ], Br[ 3 ], c, s;
+	int j, k, n;
+
+	// 3x2 matrix ( N r, B r ), applied to every ( cos, sin )
+	for ( k = 0; k < 3; k++ )
+	{
+		Nr[ k ] = N[ k ] * radius;
+		Br[ k ] = B[ k ] * radius;
+	}
+
+	n = size();
+	for ( j = 0; j < n; j++ )
+	{
+		c = _cos[ j ];
+		s = _sin[ j ];
+		for ( k = 0; k < 3; k++ )
+			out[ j ][ k ] = P[ k ] + Nr[ k ] * c + Br[ k ] * s;
+	}
+}
+
+template <class TubeType>
+void tessellate( const TubeType& tube, const typename TubeType::Type& t0, const typename TubeType::Type& t1, int nt, const Ring<typename TubeType::Type>& ring, std::vector<geom::Vector<3, typename TubeType::Type> >& points )
+{
+	RingGenerator<TubeType> rings( tube, ring, t0, t1, nt );
+	int i;
+
+	points.resize( nt * ring.size() );
+	for ( i = 0; i < nt; i++ )
+		rings.next( points.data() + i * ring.size() );
+}
+
 } // namespace
 
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace surface
+{
+
+extern template class Ring<float>;
+extern template class Ring<double>;
+extern template class Tube<float>;
+extern template class Tube<double>;
+
+} // namespace
+#endif
+
 #endif
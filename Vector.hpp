@@ -28,14 +28,23 @@
 #define GEOM_VECTOR_HPP
 
 #include <cmath>
+#include <type_traits>
 
 namespace geom
 {
 
+/**
+ * @brief Tag for constructors that leave coordinates uninitialized.
+ *
+ * For bulk buffers that are filled right after allocation.
+ */
+struct NoInit {};
+
 /**
  * @brief Generic vector/point class template.
  *
- * A class template for N-dimension vectors.
+ * A class template for N-dimension vectors. Trivially copyable, with the
+ * layout of Real[ N ] (weights are carried by WeightedPoint).
  */
 template<int N, class Real = float>
 class Vector
@@ -44,33 +53,38 @@ public:
 	/**
 	 * @brief Origin constructor.
 	 */
-	Vector()
+	constexpr Vector() :
+		_v()
+	{
+	}
+
+	/**
+	 * @brief Uninitialized constructor.
+	 */
+	explicit Vector( NoInit )
 	{
-		for ( int i = 0; i < N; i++ )
-			_v[ i ] = 0.;
-		_w = 1.;
 	}
 
 	/**
-	 * @brief Copy constructor.
+	 * @brief Conversion from another real type.
 	 */
-	Vector( const Vector & vect )
+	template <class Other>
+	constexpr explicit Vector( const Vector<N, Other> & vect ) :
+		_v()
 	{
 		for ( int i = 0; i < N; i++ )
 			_v[ i ] = vect[ i ];
-		_w = vect.weight();
 	}
 
 	/**
 	 * @brief Constructor from a C-array of Real.
 	 * @param vect A C-array of Real.
-	 * @param w The weight (default : 1).
 	 */
-	Vector( const Real * vect, const Real & w = 1. )
+	constexpr Vector( const Real * vect ) :
+		_v()
 	{
 		for ( int i = 0; i < N; i++ )
 			_v[ i ] = vect[ i ];
-		_w = w;
 	}
 
 	/**
@@ -78,7 +92,7 @@ public:
 	 * @param i 0 is x, 1 is y, 2 is z, ...
 	 * @return The i-th coordinate.
 	 */
-	inline const Real & operator[]( int i ) const
+	constexpr const Real & operator[]( int i ) const
 	{
 		return _v[ i ];
 	}
@@ -88,7 +102,7 @@ public:
 	 * @param i 0 is x, 1 is y, 2 is z, ...
 	 * @return The i-th coordinate.
 	 */
-	inline Real & operator[]( int i )
+	constexpr Real & operator[]( int i )
 	{
 		return _v[ i ];
 	}
@@ -96,7 +110,7 @@ public:
 	/**
 	 * @brief Equal to operator.
 	 */
-	inline bool operator==( const Vector & vect ) const
+	constexpr bool operator==( const Vector & vect ) const
 	{
 		bool res = true;
 
@@ -108,7 +122,7 @@ public:
 	/**
 	 * @brief Not equal to operator.
 	 */
-	inline bool operator!=( const Vector & vect ) const
+	constexpr bool operator!=( const Vector & vect ) const
 	{
 		bool res = false;
 
@@ -120,7 +134,7 @@ public:
 	/**
 	 * @brief Addition operator.
 	 */
-	inline const Vector operator+( const Vector & vect ) const
+	constexpr const Vector operator+( const Vector & vect ) const
 	{
 		Vector res;
 
@@ -132,7 +146,7 @@ public:
 	/**
 	 * @brief Addition assignment operator.
 	 */
-	inline Vector & operator+=( const Vector & vect )
+	constexpr Vector & operator+=( const Vector & vect )
 	{
 		for ( int i = 0; i < N; i++ )
 			_v[ i ] += vect[ i ];
@@ -142,7 +156,7 @@ public:
 	/**
 	 * @brief Subtraction operator.
 	 */
-	inline const Vector operator-( const Vector & vect ) const
+	constexpr const Vector operator-( const Vector & vect ) const
 	{
 		Vector res;
 
@@ -154,7 +168,7 @@ public:
 	/**
 	 * @brief Subtraction assignment operator.
 	 */
-	inline Vector & operator-=( const Vector & vect )
+	constexpr Vector & operator-=( const Vector & vect )
 	{
 		Vector res;
 
@@ -166,7 +180,7 @@ public:
 	/**
 	 * @brief Minus operator.
 	 */
-	inline const Vector operator-() const
+	constexpr const Vector operator-() const
 	{
 		Vector res;
 
@@ -178,19 +192,28 @@ public:
 	/**
 	 * @brief Dot product.
 	 */
-	inline Real operator*( const Vector & vect ) const
+	constexpr Real operator*( const Vector & vect ) const
+	{
+		return dot( vect );
+	}
+
+	/**
+	 * @brief Dot product, accumulated in Compute (e.g. double for float vectors).
+	 */
+	template <class Compute = Real>
+	constexpr Compute dot( const Vector & vect ) const
 	{
-		Real r = 0.;
+		Compute r = 0.;
 
 		for ( int i = 0; i < N; i++ )
-			r += _v[ i ] * vect[ i ];
+			r += (Compute)_v[ i ] * vect[ i ];
 		return r;
 	}
 
 	/**
 	 * @brief Multiplication with a scalar.
 	 */
-	inline const Vector operator*( const Real & r ) const
+	constexpr const Vector operator*( const Real & r ) const
 	{
 		Vector vect;
 
@@ -202,7 +225,7 @@ public:
 	/**
 	 * @brief Multiplication assignment with a scalar.
 	 */
-	inline Vector & operator*=( const Real & r )
+	constexpr Vector & operator*=( const Real & r )
 	{
 		for ( int i = 0; i < N; i++ )
 			_v[ i ] *= r;
@@ -212,7 +235,7 @@ public:
 	/**
 	 * @brief Division with a scalar.
 	 */
-	inline const Vector operator/( const Real & r ) const
+	constexpr const Vector operator/( const Real & r ) const
 	{
 		Vector res;
 
@@ -224,56 +247,161 @@ public:
 	/**
 	 * @brief Division assignment with a scalar.
 	 */
-	inline Vector & operator/=( const Real & r )
+	constexpr Vector & operator/=( const Real & r )
 	{
 		for ( int i = 0; i < N; i++ )
 			_v[ i ] /= r;
 		return *this;
 	}
 
+	/**
+	 * @brief Returns the length.
+	 * @return The length, computed in Compute.
+	 */
+	template <class Compute = Real>
+	inline Compute length() const { return sqrt( dot<Compute>( *this ) ); }
+
+	/**
+	 * @brief Makes an unit vector.
+	 */
+	inline void normalize()
+	{
+		Real len;
+		int i;
+
+		len = length();
+		for ( i = 0; i < N; i++ )
+			_v[ i ] /= len;
+	}
+
+private:
+	Real _v[ N ]; /**< Coordinates data. */
+};
+
+// Layout stated above: bulk arrays of points can be copied and viewed as Real[ N ]
+static_assert( std::is_trivially_copyable<Vector<3, float> >::value, "geom::Vector must be trivially copyable" );
+static_assert( std::is_trivially_copyable<Vector<3, double> >::value, "geom::Vector must be trivially copyable" );
+static_assert( sizeof( Vector<2, float> ) == 2 * sizeof( float ), "geom::Vector must have the layout of Real[ N ]" );
+static_assert( sizeof( Vector<3, float> ) == 3 * sizeof( float ), "geom::Vector must have the layout of Real[ N ]" );
+static_assert( sizeof( Vector<4, float> ) == 4 * sizeof( float ), "geom::Vector must have the layout of Real[ N ]" );
+static_assert( sizeof( Vector<2, double> ) == 2 * sizeof( double ), "geom::Vector must have the layout of Real[ N ]" );
+static_assert( sizeof( Vector<3, double> ) == 3 * sizeof( double ), "geom::Vector must have the layout of Real[ N ]" );
+static_assert( sizeof( Vector<4, double> ) == 4 * sizeof( double ), "geom::Vector must have the layout of Real[ N ]" );
+
+/**
+ * @brief Weighted point class template.
+ *
+ * Control point of a rational curve: cartesian coordinates and a weight.
+ * Only stored where weights are needed (NURBS control points).
+ */
+template<int N, class Real = float>
+class WeightedPoint : public Vector<N, Real>
+{
+public:
+	/**
+	 * @brief Origin constructor (weight 1).
+	 */
+	constexpr WeightedPoint() :
+		Vector<N, Real>(), _w( 1. )
+	{
+	}
+
+	/**
+	 * @brief Uninitialized constructor.
+	 */
+	explicit WeightedPoint( NoInit ) :
+		Vector<N, Real>( NoInit() )
+	{
+	}
+
+	/**
+	 * @brief Constructor from a point and a weight.
+	 * @param point Cartesian coordinates.
+	 * @param w The weight (default : 1).
+	 */
+	constexpr WeightedPoint( const Vector<N, Real> & point, const Real & w = 1. ) :
+		Vector<N, Real>( point ), _w( w )
+	{
+	}
+
+	/**
+	 * @brief Constructor from a C-array of Real.
+	 * @param vect A C-array of Real.
+	 * @param w The weight (default : 1).
+	 */
+	constexpr WeightedPoint( const Real * vect, const Real & w = 1. ) :
+		Vector<N, Real>( vect ), _w( w )
+	{
+	}
+
+	/**
+	 * @brief Conversion from another real type.
+	 */
+	template <class Other>
+	constexpr explicit WeightedPoint( const WeightedPoint<N, Other> & point ) :
+		Vector<N, Real>( point ), _w( point.weight() )
+	{
+	}
+
+	/**
+	 * @brief Returns the cartesian coordinates.
+	 */
+	constexpr const Vector<N, Real> & point() const { return *this; }
+
 	/**
 	 * @brief Returns the const weight.
 	 * @return The weight (const).
 	 */
-	inline const Real & weight() const { return _w; }
+	constexpr const Real & weight() const { return _w; }
 
 	/**
 	 * @brief Returns the weight.
 	 * @return The weight.
 	 */
-	inline Real & weight() { return _w; }
+	constexpr Real & weight() { return _w; }
 
 	/**
-	 * @brief Returns the length.
-	 * @return The length.
+	 * @brief Returns the homogeneous coordinates ( w x, w y, ..., w ).
 	 */
-	inline Real length() const { return sqrt( (*this) * (*this) ); }
+	constexpr Vector<N+1, Real> homogeneous() const
+	{
+		Vector<N+1, Real> h;
+
+		for ( int i = 0; i < N; i++ )
+			h[ i ] = (*this)[ i ] * _w;
+		h[ N ] = _w;
+		return h;
+	}
 
 	/**
-	 * @brief Makes an unit vector.
+	 * @brief Constructs from homogeneous coordinates ( w x, w y, ..., w ).
 	 */
-	inline void normalize()
+	static constexpr WeightedPoint fromHomogeneous( const Vector<N+1, Real> & h )
 	{
-		Real len;
-		int i;
+		WeightedPoint point;
 
-		len = length();
-		for ( i = 0; i < N; i++ )
-			_v[ i ] /= len;
+		for ( int i = 0; i < N; i++ )
+			point[ i ] = h[ i ] / h[ N ];
+		point._w = h[ N ];
+		return point;
 	}
 
 private:
-	Real _v[ N ]; /**< Coordinates data. */
-	Real _w;      /**< Weight data. */
+	Real _w; /**< Weight data. */
 };
 
+static_assert( std::is_trivially_copyable<WeightedPoint<3, float> >::value, "geom::WeightedPoint must be trivially copyable" );
+static_assert( std::is_trivially_copyable<WeightedPoint<3, double> >::value, "geom::WeightedPoint must be trivially copyable" );
+static_assert( sizeof( WeightedPoint<3, float> ) == 4 * sizeof( float ), "geom::WeightedPoint must have the layout of Real[ N+1 ]" );
+static_assert( sizeof( WeightedPoint<3, double> ) == 4 * sizeof( double ), "geom::WeightedPoint must have the layout of Real[ N+1 ]" );
+
 } // namespace
 
 /**
  * @brief Cross product in 3D.
  */
 template<class Real>
-inline const geom::Vector<3, Real> operator^( const geom::Vector<3, Real> & u, const geom::Vector<3, Real> & v )
+constexpr const geom::Vector<3, Real> operator^( const geom::Vector<3, Real> & u, const geom::Vector<3, Real> & v )
 {
 	geom::Vector<3, Real> w;
 
@@ -287,7 +415,7 @@ inline const geom::Vector<3, Real> operator^( const geom::Vector<3, Real> & u, c
  * @brief Cross product in 7D.
  */
 template<class Real>
-inline const geom::Vector<7, Real> operator^( const geom::Vector<7, Real> & u, const geom::Vector<7, Real> & v )
+constexpr const geom::Vector<7, Real> operator^( const geom::Vector<7, Real> & u, const geom::Vector<7, Real> & v )
 {
 	geom::Vector<7, Real> w;
 
@@ -313,20 +441,19 @@ public:
 	/**
 	 * @brief Constructor from a C-array of Real.
 	 */
-	Vector2( const Real * vect, const Real & w = 1. ) :
-		Vector<2, Real>( vect, w )
+	constexpr Vector2( const Real * vect ) :
+		Vector<2, Real>( vect )
 	{
 	}
 
 	/**
 	 * @brief Constructor from two coordinates.
 	 */
-	Vector2( const Real & x, const Real & y, const Real & w = 1. ) :
+	constexpr Vector2( const Real & x, const Real & y ) :
 		Vector<2, Real>()
 	{
 		(*this)[ 0 ] = x;
 		(*this)[ 1 ] = y;
-		(*this).weight() = w;
 	}
 };
 
@@ -337,21 +464,20 @@ public:
 	/**
 	 * @brief Constructor from a C-array of Real.
 	 */
-	Vector3( const Real * vect, const Real & w = 1. ) :
-		Vector<3, Real>( vect, w )
+	constexpr Vector3( const Real * vect ) :
+		Vector<3, Real>( vect )
 	{
 	}
 
 	/**
 	 * @brief Constructor from three coordinates.
 	 */
-	Vector3( const Real & x, const Real & y, const Real & z, const Real & w = 1. ) :
+	constexpr Vector3( const Real & x, const Real & y, const Real & z ) :
 		Vector<3, Real>()
 	{
 		(*this)[ 0 ] = x;
 		(*this)[ 1 ] = y;
 		(*this)[ 2 ] = z;
-		(*this).weight() = w;
 	}
 };
 
@@ -362,22 +488,21 @@ public:
 	/**
 	 * @brief Constructor from a C-array of Real.
 	 */
-	Vector4( const Real * vect, const Real & w = 1. ) :
-		Vector<4, Real>( vect, w )
+	constexpr Vector4( const Real * vect ) :
+		Vector<4, Real>( vect )
 	{
 	}
 
 	/**
 	 * @brief Constructor from four coordinates.
 	 */
-	Vector4( const Real & x, const Real & y, const Real & z, const Real & t, const Real & w = 1. ) :
+	constexpr Vector4( const Real & x, const Real & y, const Real & z, const Real & t ) :
 		Vector<4, Real>()
 	{
 		(*this)[ 0 ] = x;
 		(*this)[ 1 ] = y;
 		(*this)[ 2 ] = z;
 		(*this)[ 3 ] = t;
-		(*this).weight() = w;
 	}
 };
 
@@ -402,35 +527,45 @@ std::ostream & operator<<( std::ostream & os, const geom::Vector<N, Real> & v )
 {
 	os << "(";
 	for ( int i = 0; i < N; i++ )
-		os << v[ i ] << ", ";
-	os << v.weight() << ")";
+		os << ( i ? ", " : "" ) << v[ i ];
+	os << ")";
 	return os;
 }
 
-// OpenSceneGraph
-
-#include <osg/Vec2>
-#include <osg/Vec3>
-
 /**
- * @brief Converts a geom::Vector<2> into a osg::Vec2.
+ * @brief Displays coordinates and weight.
  */
-template<class Real>
-const geom::Vector<2, Real> & operator>>( const geom::Vector<2, Real> & u, osg::Vec2 & v )
+template<int N, class Real>
+std::ostream & operator<<( std::ostream & os, const geom::WeightedPoint<N, Real> & v )
 {
-	v.set( u[ 0 ], u[ 1 ] );
-	return u;
+	os << "(";
+	for ( int i = 0; i < N; i++ )
+		os << v[ i ] << ", ";
+	os << v.weight() << ")";
+	return os;
 }
 
-/**
- * @brief Converts a geom::Vector<3> into a osg::Vec3.
- */
-template<class Real>
-const geom::Vector<3, Real> & operator>>( const geom::Vector<3, Real> & u, osg::Vec3 & v )
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace geom
 {
-	v.set( u[ 0 ], u[ 1 ], u[ 2 ] );
-	return u;
-}
+
+extern template class Vector<2, float>;
+extern template class Vector<3, float>;
+extern template class Vector<4, float>;
+extern template class Vector<2, double>;
+extern template class Vector<3, double>;
+extern template class Vector<4, double>;
+extern template class WeightedPoint<2, float>;
+extern template class WeightedPoint<3, float>;
+extern template class WeightedPoint<4, float>;
+extern template class WeightedPoint<2, double>;
+extern template class WeightedPoint<3, double>;
+extern template class WeightedPoint<4, double>;
+
+} // namespace
+#endif
 
 #endif
 
@@ -0,0 +1,299 @@
+/** -*- C++ -*-
+ * @file View.hpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef CURVE_VIEW_HPP
+#define CURVE_VIEW_HPP
+
+#include "Parametric.hpp"
+#include "Basis.hpp"
+#include "Instrument.hpp"
+#include <cstddef>
+#include <algorithm>
+
+namespace curve
+{
+
+/**
+ * @brief Non-owning strided array of reals.
+ *
+ * Element i is data[ i * stride ]; for two-dimensional arrays, component k
+ * of element i is data[ i * stride + k * componentStride ]. This covers
+ * packed arrays (stride 1), arrays of structures (stride = structure size)
+ * and structures of arrays (stride 1, componentStride = array size).
+ * Strides are counted in reals.
+ */
+template <class Real>
+class Strided
+{
+public:
+	Strided( const Real * data = 0, std::ptrdiff_t stride = 1, std::ptrdiff_t componentStride = 1 ) :
+		_data( data ), _stride( stride ), _componentStride( componentStride ) {}
+
+	inline const Real & operator[]( std::ptrdiff_t i ) const { return _data[ i * _stride ]; }
+	inline const Real & operator()( std::ptrdiff_t i, int k ) const { return _data[ i * _stride + k * _componentStride ]; }
+
+	const Real * data() const             { return _data; }
+	std::ptrdiff_t stride() const         { return _stride; }
+	std::ptrdiff_t componentStride() const { return _componentStride; }
+
+private:
+	const Real * _data;
+	std::ptrdiff_t _stride;
+	std::ptrdiff_t _componentStride;
+};
+
+/**
+ * @brief Spline curve over caller-provided arrays.
+ *
+ * Evaluates directly from external knot and coordinate arrays (shared
+ * memory, mapped files, staging buffers...) with the algorithms of NURBS,
+ * without copying them into geom::Vector objects. The arrays must outlive
+ * the view.
+ */
+template <int N, class Real = float>
+class SplineView : public Parametric<N, Real>
+{
+public:
+	typedef geom::Vector<N, Real> Point;
+	typedef geom::WeightedPoint<N, Real> ControlPoint;
+
+	/**
+	 * @brief Empty view constructor.
+	 */
+	SplineView() :
+		_count( 0 ), _degree( 0 ), _clamped( true ), _uniform( false ), _homogeneous( false ) {}
+
+	/**
+	 * @param count Number of control points.
+	 * @param degree The degree.
+	 * @param knots The knots (count+degree+1 values).
+	 * @param coordinates Coordinate k of point i at coordinates( i, k ).
+	 * @param clamped Clamps the parameter if true, wraps it around otherwise.
+	 */
+	SplineView( int count, int degree, const Strided<Real> & knots, const Strided<Real> & coordinates, bool clamped = true ) :
+		_count( count ), _degree( degree ), _clamped( clamped ), _uniform( false ), _homogeneous( false ),
+		_knots( knots ), _coordinates( coordinates ) {}
+
+	virtual Point operator()( const Real& t ) const;
+	virtual Point derivative( const Real& t, int k = 1 ) const;
+
+	int getDegree() const { return _degree; }
+	int size() const      { return _count; }
+	bool isClamped() const { return _clamped; }
+	bool isRational() const { return _weights.data() != 0; }
+
+	/**
+	 * @brief Checks if the knots are declared equally spaced.
+	 */
+	bool isUniform() const { return _uniform; }
+
+	/**
+	 * @brief Declares the knots equally spaced (in the valid range), for
+	 * a span lookup without search. The knots are not checked.
+	 */
+	void setUniform( bool uniform ) { _uniform = uniform; }
+
+	const Strided<Real>& knots() const       { return _knots; }
+	const Strided<Real>& coordinates() const { return _coordinates; }
+	const Strided<Real>& weights() const     { return _weights; }
+
+	/**
+	 * @brief Returns control point i, in cartesian coordinates with its weight.
+	 */
+	ControlPoint controlPoint( int i ) const;
+
+	/**
+	 * @brief Returns the knot span of u (see Spline::findSpan).
+	 */
+	int findSpan( const Real& u ) const
+	{
+		if ( _uniform )
+			return basis::uniformSpan( _count - 1, _degree, u, _knots );
+		return basis::findSpan( _count - 1, _degree, u, _knots );
+	}
+
+protected:
+	int _count;
+	int _degree;
+	bool _clamped;
+	bool _uniform;
+	bool _homogeneous;            /**< Coordinates are premultiplied by the weights. */
+	Strided<Real> _knots;
+	Strided<Real> _coordinates;
+	Strided<Real> _weights;       /**< Null for non-rational curves. */
+
+	/**
+	 * @brief Keeps u value in the good interval.
+	 */
+	void adjustParameter( Real & u ) const
+	{
+		basis::adjustParameter( u, _knots[ 0 ], _knots[ _count + _degree ], _clamped );
+	}
+};
+
+/**
+ * @brief NURBS curve over caller-provided arrays.
+ *
+ * As SplineView, plus a weight array. Coordinates are either cartesian
+ * ( x, y, ... ) or homogeneous ( w x, w y, ... ).
+ */
+template <int N, class Real = float>
+class NURBSView : public SplineView<N, Real>
+{
+public:
+	/**
+	 * @brief Empty view constructor.
+	 */
+	NURBSView() : SplineView<N, Real>() {}
+
+	/**
+	 * @param weights Weight of point i at weights[ i ].
+	 * @param homogeneous True if the coordinates are premultiplied by the weights.
+	 * @see SplineView
+	 */
+	NURBSView( int count, int degree, const Strided<Real> & knots, const Strided<Real> & coordinates,
+		const Strided<Real> & weights, bool homogeneous = false, bool clamped = true ) :
+		SplineView<N, Real>( count, degree, knots, coordinates, clamped )
+	{
+		this->_weights = weights;
+		this->_homogeneous = homogeneous;
+	}
+};
+
+// -----------------------------------------------------------------------------
+
+template <int N, class Real>
+typename SplineView<N, Real>::ControlPoint SplineView<N, Real>::controlPoint( int i ) const
+{
+	ControlPoint P;
+	Real w;
+	int k;
+
+	w = isRational() ? _weights[ i ] : 1;
+	for ( k = 0; k < N; k++ )
+		P[ k ] = _homogeneous ? _coordinates( i, k ) / w : _coordinates( i, k );
+	P.weight() = w;
+	return P;
+}
+
+template <int N, class Real>
+typename SplineView<N, Real>::Point SplineView<N, Real>::operator()( const Real& t ) const
+{
+	Real N_[ _degree+1 ];
+	Point C;
+	Real u = t, w, Nw;
+	int span, p, i, j, k;
+
+	GEOM_SCOPE( CurvePoint );
+
+	p = _degree;
+	adjustParameter( u );
+	span = findSpan( u );
+	basis::basisFuns( span, u, p, _knots, N_ );
+
+	if ( !isRational() )
+	{
+		for ( j = 0; j <= p; j++ )
+		{
+			for ( k = 0; k < N; k++ )
+				C[ k ] += N_[ j ] * _coordinates( span-p+j, k );
+		}
+		return C;
+	}
+
+	w = 0.;
+	for ( j = 0; j <= p; j++ )
+	{
+		i = span-p+j;
+		Nw = N_[ j ] * _weights[ i ];
+		for ( k = 0; k < N; k++ )
+			C[ k ] += ( _homogeneous ? N_[ j ] : Nw ) * _coordinates( i, k );
+		w += Nw;
+	}
+	// Divide by weight
+	return C / w;
+}
+
+template <int N, class Real>
+typename SplineView<N, Real>::Point SplineView<N, Real>::derivative( const Real& t, int d ) const
+{
+	Real nders[ ( d+1 ) * ( _degree+1 ) ], wders[ d+1 ], Nk, Nw;
+	Point Aders[ d+1 ];
+	Real u = t;
+	int span, p, du, i, j, k, l;
+
+	GEOM_COUNT( Derivative );
+	GEOM_SCOPE( CurveDerivs );
+
+	p = _degree;
+	du = std::min( d, p );
+	adjustParameter( u );
+	span = findSpan( u );
+	basis::dersBasisFuns( span, u, p, du, _knots, nders );
+
+	// Derivatives of the homogeneous curve (zero above the degree)
+	for ( k = 0; k <= d; k++ )
+		wders[ k ] = 0.;
+	for ( k = 0; k <= du; k++ )
+	{
+		for ( j = 0; j <= p; j++ )
+		{
+			i = span-p+j;
+			Nk = nders[ k*(p+1) + j ];
+			Nw = isRational() ? Nk * _weights[ i ] : Nk;
+			for ( l = 0; l < N; l++ )
+				Aders[ k ][ l ] += ( _homogeneous ? Nk : Nw ) * _coordinates( i, l );
+			wders[ k ] += Nw;
+		}
+	}
+
+	if ( !isRational() )
+		return Aders[ d ];
+
+	basis::rationalDerivs( Aders, wders, d );
+	return Aders[ d ];
+}
+
+} // namespace
+
+// Explicit instantiations (see Instances.cpp)
+
+#ifdef GEOM_EXTERN_TEMPLATES
+namespace curve
+{
+
+extern template class SplineView<2, float>;
+extern template class SplineView<3, float>;
+extern template class SplineView<4, float>;
+extern template class SplineView<2, double>;
+extern template class SplineView<3, double>;
+extern template class SplineView<4, double>;
+
+} // namespace
+#endif
+
+#endif
@@ -0,0 +1,828 @@
+/**
+ * @file benchmark.cpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Micro and macro benchmarks (Google Benchmark).
+ *
+ * Machine-readable output:
+ *   benchmark --benchmark_format=json
+ *   benchmark --benchmark_out=results.json --benchmark_out_format=json
+ */
+
+#include "NURBS.hpp"
+#include "FixedNURBS.hpp"
+#include "View.hpp"
+#include "Sampling.hpp"
+#include "Bundle.hpp"
+#include "Fit.hpp"
+#include "Algebra.hpp"
+#include "Transform.hpp"
+#include "Frenet.hpp"
+#include "Table.hpp"
+#include "Tube.hpp"
+#include "Sweep.hpp"
+#include "Simpson.hpp"
+#include "Intersection.hpp"
+#include "Binary.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief Deterministic pseudo-random number in [0, 1).
+ */
+template <class Real>
+Real random( unsigned & seed )
+{
+	seed = seed * 1664525u + 1013904223u;
+	return (Real)( seed >> 8 ) / (Real)( 1 << 24 );
+}
+
+/**
+ * @brief Builds a uniform curve with random control points in [0, 1)^N.
+ */
+template <int N, class Real>
+curve::NURBS<N, Real> makeCurve( int count, int degree, unsigned seed = 12345 )
+{
+	std::vector<geom::WeightedPoint<N, Real> > points( count );
+	int i, j;
+
+	for ( i = 0; i < count; i++ )
+	{
+		for ( j = 0; j < N; j++ )
+			points[ i ][ j ] = random<Real>( seed );
+	}
+	return curve::NURBS<N, Real>( std::move( points ), degree );
+}
+
+/**
+ * @brief Parameters spread over [0, 1) (golden ratio sequence).
+ */
+template <class Real>
+class Parameters
+{
+public:
+	Parameters() : _t( 0 ) {}
+
+	inline Real next()
+	{
+		_t += (Real)0.6180339887;
+		if ( _t >= 1 ) _t -= 1;
+		return _t;
+	}
+
+private:
+	Real _t;
+};
+
+/**
+ * @brief Builds n random vectors.
+ */
+template <int N, class Real>
+std::vector<geom::Vector<N, Real> > makeVectors( int n )
+{
+	std::vector<geom::Vector<N, Real> > v( n );
+	unsigned seed = 6789;
+	int i, j;
+
+	for ( i = 0; i < n; i++ )
+	{
+		for ( j = 0; j < N; j++ )
+			v[ i ][ j ] = random<Real>( seed );
+	}
+	return v;
+}
+
+/**
+ * @brief Builds n random N x N matrices.
+ */
+template <int N, class Real>
+std::vector<geom::Matrix<N, N, Real> > makeMatrices( int n )
+{
+	std::vector<geom::Vector<N, Real> > u( makeVectors<N, Real>( n * N ) );
+	std::vector<geom::Matrix<N, N, Real> > m( n );
+	int i;
+
+	for ( i = 0; i < n; i++ )
+		m[ i ].setColumns( &u[ i * N ] );
+	return m;
+}
+
+// Curves -------------------------------------------------------------------
+
+template <class Real, class Compute = Real>
+void NURBS_Point( benchmark::State& state )
+{
+	curve::NURBS<3, Real, Compute> c( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ).controlPoints(), state.range( 0 ) );
+	Parameters<Real> t;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( c( t.next() ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void FixedNURBS_Point( benchmark::State& state )
+{
+	curve::NURBS<3, Real> nurbs( makeCurve<3, Real>( 16, state.range( 0 ) ) );
+	curve::FixedNURBS<3, 16, Real> c( nurbs.controlPoints().data(), 16, state.range( 0 ) );
+	Parameters<Real> t;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( c( t.next() ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void NURBS_Point_NonUniform( benchmark::State& state )
+{
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	std::vector<Real> knots( c.knotVector() );
+	unsigned seed = 42;
+	Parameters<Real> t;
+	std::size_t i;
+
+	// Perturbed interior knots
+	for ( i = c.getDegree() + 1; i + c.getDegree() + 1 < knots.size(); i++ )
+		knots[ i ] = knots[ i - 1 ] + ( knots[ i + 1 ] - knots[ i - 1 ] ) * ( (Real)0.25 + random<Real>( seed ) / 2 );
+	c.setKnotVector( std::move( knots ) );
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( c( t.next() ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void SplineView_Point( benchmark::State& state )
+{
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	std::vector<Real> coordinates;
+	Parameters<Real> t;
+
+	// Packed x, y, z
+	for ( const auto & P : c.controlPoints() )
+		coordinates.insert( coordinates.end(), { P[ 0 ], P[ 1 ], P[ 2 ] } );
+
+	curve::SplineView<3, Real> v( c.controlPoints().size(), c.getDegree(),
+		curve::Strided<Real>( c.knotVector().data() ), curve::Strided<Real>( coordinates.data(), 3 ) );
+	v.setUniform( c.isUniform() );
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( v( t.next() ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void NURBS_Derivative( benchmark::State& state )
+{
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	Parameters<Real> t;
+	int d = state.range( 2 );
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( c.derivative( t.next(), d ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void NURBS_Evaluate( benchmark::State& state )
+{
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	std::vector<Real> parameters( 4096 );
+	std::vector<geom::Vector<3, Real> > points( parameters.size() );
+	Parameters<Real> t;
+	std::size_t i;
+	int d = state.range( 2 );
+
+	// Batch evaluation, basis functions computed over several parameters at once
+	for ( i = 0; i < parameters.size(); i++ )
+		parameters[ i ] = t.next();
+
+	// Kernel variant (see Dispatch.hpp)
+	if ( !geom::cpu::setIsa( (geom::cpu::Isa)state.range( 3 ) ) )
+	{
+		state.SkipWithError( "instruction set not supported" );
+		return;
+	}
+	state.SetLabel( geom::cpu::name( geom::cpu::isa() ) );
+
+	for ( auto _ : state )
+	{
+		c.evaluate( parameters.data(), points.data(), parameters.size(), d );
+		benchmark::DoNotOptimize( points.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * parameters.size() );
+	geom::cpu::setIsa( geom::cpu::best() );
+}
+
+template <class Real>
+void Sampling_Evaluate( benchmark::State& state )
+{
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	std::vector<Real> parameters( 65536 );
+	std::vector<geom::Vector<3, Real> > points;
+	std::size_t i;
+
+	// Fixed parameters, evaluated again after each control point update
+	for ( i = 0; i < parameters.size(); i++ )
+		parameters[ i ] = i / (Real)parameters.size();
+	curve::SamplingPlan<3, Real> plan( c, parameters );
+	plan.bind( c.controlPoints() );
+	points.resize( plan.size() );
+
+	for ( auto _ : state )
+	{
+		plan.evaluate( points.data(), 0, state.range( 2 ) );
+		benchmark::DoNotOptimize( points.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * parameters.size() );
+}
+
+template <class Real>
+void Bundle_Curves( benchmark::State& state )
+{
+	std::vector<curve::NURBS<3, Real> > curves;
+	std::vector<geom::Vector<3, Real> > points( state.range( 1 ) );
+	Parameters<Real> t;
+	int i, n = state.range( 1 );
+
+	// Baseline: one evaluation per curve, at the same parameter
+	for ( i = 0; i < n; i++ )
+		curves.push_back( makeCurve<3, Real>( 16, state.range( 0 ), i + 1 ) );
+
+	for ( auto _ : state )
+	{
+		Real u = t.next();
+		for ( i = 0; i < n; i++ )
+			points[ i ] = curves[ i ]( u );
+		benchmark::DoNotOptimize( points.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * n );
+}
+
+template <class Real>
+void Bundle_Evaluate( benchmark::State& state )
+{
+	curve::Bundle<3, Real> bundle( makeCurve<3, Real>( 16, state.range( 0 ) ) );
+	std::vector<geom::Vector<3, Real> > points( state.range( 1 ) );
+	Parameters<Real> t;
+	int i, n = state.range( 1 );
+
+	for ( i = 0; i < n; i++ )
+		bundle.push( makeCurve<3, Real>( 16, state.range( 0 ), i + 1 ) );
+
+	for ( auto _ : state )
+	{
+		bundle( t.next(), points.data() );
+		benchmark::DoNotOptimize( points.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * n );
+}
+
+template <class Real>
+void Fit_Interpolate( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > Q;
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( 16, 3 ) );
+	int i, n = state.range( 0 );
+
+	// Points along a curve
+	Q.resize( n );
+	for ( i = 0; i < n; i++ )
+		Q[ i ] = c( i / (Real)( n - 1 ) );
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( curve::interpolate( Q, 3 ) );
+	state.SetItemsProcessed( state.iterations() * n );
+}
+
+template <class Real>
+void Fit_Approximate( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > Q;
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( 16, 3 ) );
+	int i, n = state.range( 0 );
+
+	// Points along a curve, fitted with one control point per 16 points
+	Q.resize( n );
+	for ( i = 0; i < n; i++ )
+		Q[ i ] = c( i / (Real)( n - 1 ) );
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( curve::approximate( Q, n / 16, 3 ) );
+	state.SetItemsProcessed( state.iterations() * n );
+}
+
+template <class Real>
+void Parametric_Length( benchmark::State& state )
+{
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	integral::Simpson<Real> simpson;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( c.length( simpson ) );
+}
+
+template <class Real, class Compute = Real>
+void Static_Length( benchmark::State& state )
+{
+	curve::NURBS<3, Real, Compute> c( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ).controlPoints(), state.range( 0 ) );
+	integral::Simpson<Real, Compute> simpson;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( curve::length( c, (Real)0, (Real)1, simpson ) );
+}
+
+// Frames and surfaces ------------------------------------------------------
+
+template <class Real>
+void Frenet( benchmark::State& state )
+{
+	frame::Frenet<Real> f( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	Parameters<Real> t;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( f( t.next() ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void StaticFrenet( benchmark::State& state )
+{
+	frame::StaticFrenet<curve::NURBS<3, Real> > f( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	Parameters<Real> t;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( f( t.next() ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void Frame_Table( benchmark::State& state )
+{
+	frame::Frenet<Real> f( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	frame::Table<Real> table( f, 0, 1, 4 * state.range( 1 ), (typename frame::Table<Real>::Interpolation)state.range( 2 ) );
+	Parameters<Real> t;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( table( t.next() ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void Tube( benchmark::State& state )
+{
+	surface::Tube<Real> s( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ), frame::Frenet<Real>() );
+	Parameters<Real> t;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( s( t.next(), (Real)1 ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void StaticTube( benchmark::State& state )
+{
+	surface::StaticTube<curve::NURBS<3, Real> > s( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	Parameters<Real> t;
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize( s( t.next(), (Real)1 ) );
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void Sweep_Tessellate( benchmark::State& state )
+{
+	curve::NURBS<2, Real> profile( makeCurve<2, Real>( 8, 3 ) );
+	surface::Sweep<Real> s( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ), frame::Frenet<Real>(), profile );
+	std::vector<geom::Vector<3, Real> > points;
+	int rings = 64, n = state.range( 2 );
+
+	for ( auto _ : state )
+	{
+		s.tessellate( 0, 1, rings, 0, 1, n, points );
+		benchmark::DoNotOptimize( points.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * rings * n );
+}
+
+template <class Real>
+void Tube_Points( benchmark::State& state )
+{
+	surface::StaticTube<curve::NURBS<3, Real> > s( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	std::vector<geom::Vector<3, Real> > points;
+	int rings = 64, n = state.range( 2 ), i, j;
+
+	// Baseline: one curve and frame evaluation per point
+	points.resize( rings * n );
+	for ( auto _ : state )
+	{
+		for ( i = 0; i < rings; i++ )
+			for ( j = 0; j < n; j++ )
+				points[ i * n + j ] = s( i / (Real)( rings - 1 ), 2 * (Real)3.14159265358979323846 * j / n );
+		benchmark::DoNotOptimize( points.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * rings * n );
+}
+
+template <class Real>
+void Tube_Rings( benchmark::State& state )
+{
+	surface::StaticTube<curve::NURBS<3, Real> > s( makeCurve<3, Real>( state.range( 1 ), state.range( 0 ) ) );
+	surface::RingGenerator<surface::StaticTube<curve::NURBS<3, Real> > > g( s, surface::Ring<Real>( state.range( 2 ) ), 0, 1, 64 );
+	std::vector<geom::Vector<3, Real> > ring( g.ringSize() );
+
+	for ( auto _ : state )
+	{
+		g.reset();
+		while ( g.next( ring.data() ) )
+			benchmark::DoNotOptimize( ring.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * g.count() * g.ringSize() );
+}
+
+// Intersections ------------------------------------------------------------
+
+template <class Real>
+void Intersection_Pair( benchmark::State& state )
+{
+	curve::NURBS<2, Real> a( makeCurve<2, Real>( state.range( 1 ), state.range( 0 ), 1 ) );
+	curve::NURBS<2, Real> b( makeCurve<2, Real>( state.range( 1 ), state.range( 0 ), 2 ) );
+	intersection::CurveCurve<2, Real> intersect;
+	std::vector<intersection::Hit<2, Real> > hits;
+
+	for ( auto _ : state )
+	{
+		hits.clear();
+		intersect( a, b, hits );
+		benchmark::DoNotOptimize( hits.data() );
+	}
+	state.counters[ "hits" ] = hits.size();
+}
+
+template <class Real>
+void Intersection_Batch( benchmark::State& state )
+{
+	std::vector<curve::NURBS<2, Real> > curves;
+	std::vector<geom::WeightedPoint<2, Real> > points;
+	intersection::CurveCurve<2, Real> intersect;
+	std::vector<intersection::Hit<2, Real> > hits;
+	unsigned seed = 999;
+	int i, n = state.range( 0 );
+	Real side = std::sqrt( (Real)n ) / 2;
+
+	// Unit-sized curves spread over a square, a few neighbours each
+	for ( i = 0; i < n; i++ )
+	{
+		geom::Vector<2, Real> offset;
+		offset[ 0 ] = random<Real>( seed ) * side;
+		offset[ 1 ] = random<Real>( seed ) * side;
+		points = makeCurve<2, Real>( 8, 3, i + 1 ).controlPoints();
+		for ( auto & p : points )
+			p += offset;
+		curves.push_back( curve::NURBS<2, Real>( std::move( points ), 3 ) );
+	}
+
+	for ( auto _ : state )
+	{
+		hits.clear();
+		intersect( curves, hits, state.range( 1 ) );
+		benchmark::DoNotOptimize( hits.data() );
+	}
+	state.counters[ "hits" ] = hits.size();
+	state.SetItemsProcessed( state.iterations() * n );
+}
+
+// Binary files -------------------------------------------------------------
+
+template <class Real>
+void Binary_Write( benchmark::State& state )
+{
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( 16, 3 ) );
+	int i, n = state.range( 0 );
+
+	for ( auto _ : state )
+	{
+		io::Writer<3, Real> writer( "geom_benchmark.bin" );
+		for ( i = 0; i < n; i++ )
+			writer.write( c );
+		writer.close();
+	}
+	state.SetItemsProcessed( state.iterations() * n );
+}
+
+template <class Real>
+void Binary_Read( benchmark::State& state )
+{
+	curve::NURBS<3, Real> c( makeCurve<3, Real>( 16, 3 ) );
+	Parameters<Real> t;
+	std::size_t i, n = state.range( 0 );
+
+	{
+		io::Writer<3, Real> writer( "geom_benchmark.bin" );
+		for ( i = 0; i < n; i++ )
+			writer.write( c );
+	}
+
+	// Open, index and evaluate each curve once
+	for ( auto _ : state )
+	{
+		io::Reader<3, Real> reader( "geom_benchmark.bin" );
+		for ( i = 0; i < reader.size(); i++ )
+			benchmark::DoNotOptimize( reader[ i ]( t.next() ) );
+	}
+	state.SetItemsProcessed( state.iterations() * n );
+}
+
+// Vectors and matrices -----------------------------------------------------
+
+template <class Real>
+void Vector_Add( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > u( makeVectors<3, Real>( state.range( 0 ) ) ), v( u );
+	std::size_t i;
+
+	for ( auto _ : state )
+	{
+		for ( i = 0; i < u.size(); i++ )
+			v[ i ] = v[ i ] + u[ i ];
+		benchmark::DoNotOptimize( v.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * u.size() );
+}
+
+template <class Real>
+void Vector_Dot( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > u( makeVectors<3, Real>( state.range( 0 ) ) );
+	std::size_t i;
+	Real r;
+
+	for ( auto _ : state )
+	{
+		r = 0;
+		for ( i = 1; i < u.size(); i++ )
+			r += u[ i - 1 ] * u[ i ];
+		benchmark::DoNotOptimize( r );
+	}
+	state.SetItemsProcessed( state.iterations() * u.size() );
+}
+
+template <class Real>
+void Vector_Cross( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > u( makeVectors<3, Real>( state.range( 0 ) ) ), v( u );
+	std::size_t i;
+
+	for ( auto _ : state )
+	{
+		for ( i = 1; i < u.size(); i++ )
+			v[ i ] = u[ i - 1 ] ^ u[ i ];
+		benchmark::DoNotOptimize( v.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * u.size() );
+}
+
+template <class Real>
+void Vector_Normalize( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > u( makeVectors<3, Real>( state.range( 0 ) ) ), v;
+	std::size_t i;
+
+	for ( auto _ : state )
+	{
+		v = u;
+		for ( i = 0; i < v.size(); i++ )
+			v[ i ].normalize();
+		benchmark::DoNotOptimize( v.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * u.size() );
+}
+
+template <class Real>
+void Matrix_Product( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > u( makeVectors<3, Real>( 3 ) );
+	geom::Matrix<3, 3, Real> a, b;
+
+	a.setColumns( u.data() );
+	b = a;
+	for ( auto _ : state )
+	{
+		b = a * b;
+		b /= b( 0, 0 );
+		benchmark::DoNotOptimize( b );
+	}
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <class Real>
+void Matrix_Vector( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > u( makeVectors<3, Real>( state.range( 0 ) ) ), v( u );
+	geom::Matrix<3, 3, Real> m;
+	std::size_t i;
+
+	m.setColumns( u.data() );
+	for ( auto _ : state )
+	{
+		for ( i = 0; i < u.size(); i++ )
+			v[ i ] = m * u[ i ];
+		benchmark::DoNotOptimize( v.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * u.size() );
+}
+
+template <class Real>
+void Matrix_Transform( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > u( makeVectors<3, Real>( state.range( 0 ) ) ), v( u );
+	geom::Matrix<3, 3, Real> m;
+
+	m.setColumns( u.data() );
+	for ( auto _ : state )
+	{
+		geom::transform( m, u.data(), v.data(), u.size() );
+		benchmark::DoNotOptimize( v.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * u.size() );
+}
+
+template <class Real>
+void Matrix_TransformEach( benchmark::State& state )
+{
+	std::vector<geom::Vector<3, Real> > u( makeVectors<3, Real>( state.range( 0 ) ) ), v( u );
+	std::vector<geom::Matrix<3, 3, Real> > m( makeMatrices<3, Real>( state.range( 0 ) ) );
+
+	for ( auto _ : state )
+	{
+		geom::transform( m.data(), u.data(), v.data(), u.size() );
+		benchmark::DoNotOptimize( v.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * u.size() );
+}
+
+template <class Real, int N>
+void Matrix_Inverse( benchmark::State& state )
+{
+	std::vector<geom::Matrix<N, N, Real> > m( makeMatrices<N, Real>( state.range( 0 ) ) ), inv( m );
+	std::size_t i;
+
+	for ( auto _ : state )
+	{
+		for ( i = 0; i < m.size(); i++ )
+			geom::inverse( m[ i ], inv[ i ] );
+		benchmark::DoNotOptimize( inv.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * m.size() );
+}
+
+template <class Real>
+void Matrix_Eigen( benchmark::State& state )
+{
+	std::vector<geom::Matrix<3, 3, Real> > m( makeMatrices<3, Real>( state.range( 0 ) ) ), vectors( m );
+	std::vector<geom::Vector<3, Real> > values( m.size() );
+	std::size_t i;
+
+	for ( i = 0; i < m.size(); i++ )
+		m[ i ] = m[ i ] + geom::transpose( m[ i ] );
+
+	for ( auto _ : state )
+	{
+		for ( i = 0; i < m.size(); i++ )
+			geom::symmetricEigen( m[ i ], values[ i ], vectors[ i ] );
+		benchmark::DoNotOptimize( vectors.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * m.size() );
+}
+
+template <class Real>
+void Matrix_Polar( benchmark::State& state )
+{
+	std::vector<geom::Matrix<3, 3, Real> > m( makeMatrices<3, Real>( state.range( 0 ) ) ), r( m ), s( m );
+	std::size_t i;
+
+	for ( auto _ : state )
+	{
+		for ( i = 0; i < m.size(); i++ )
+			geom::polar( m[ i ], r[ i ], s[ i ] );
+		benchmark::DoNotOptimize( r.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * m.size() );
+}
+
+} // namespace
+
+#define CURVE_ARGS ArgsProduct( { { 1, 3, 5 }, { 16, 1024, 65536 } } )->ArgNames( { "degree", "points" } )
+#define FRAME_ARGS ArgsProduct( { { 3, 5 }, { 16, 1024 } } )->ArgNames( { "degree", "points" } )
+#define ARRAY_ARGS Arg( 1024 )->Arg( 65536 )->ArgName( "n" )
+
+BENCHMARK_TEMPLATE( NURBS_Point, float )->CURVE_ARGS;
+BENCHMARK_TEMPLATE( NURBS_Point, double )->CURVE_ARGS;
+BENCHMARK_TEMPLATE( NURBS_Point, float, double )->CURVE_ARGS;
+BENCHMARK_TEMPLATE( FixedNURBS_Point, float )->Arg( 3 )->Arg( 5 )->ArgName( "degree" );
+BENCHMARK_TEMPLATE( FixedNURBS_Point, double )->Arg( 3 )->Arg( 5 )->ArgName( "degree" );
+BENCHMARK_TEMPLATE( NURBS_Point_NonUniform, float )->CURVE_ARGS;
+BENCHMARK_TEMPLATE( NURBS_Point_NonUniform, double )->CURVE_ARGS;
+BENCHMARK_TEMPLATE( SplineView_Point, float )->CURVE_ARGS;
+BENCHMARK_TEMPLATE( SplineView_Point, double )->CURVE_ARGS;
+BENCHMARK_TEMPLATE( NURBS_Derivative, float )->ArgsProduct( { { 3, 5 }, { 16, 65536 }, { 1, 2, 3 } } )->ArgNames( { "degree", "points", "d" } );
+BENCHMARK_TEMPLATE( NURBS_Derivative, double )->ArgsProduct( { { 3, 5 }, { 16, 65536 }, { 1, 2, 3 } } )->ArgNames( { "degree", "points", "d" } );
+BENCHMARK_TEMPLATE( NURBS_Evaluate, float )->ArgsProduct( { { 3, 5 }, { 1024 }, { 0, 1 }, { 0, 1, 2, 3 } } )->ArgNames( { "degree", "points", "d", "isa" } );
+BENCHMARK_TEMPLATE( NURBS_Evaluate, double )->ArgsProduct( { { 3, 5 }, { 1024 }, { 0, 1 }, { 0, 1, 2, 3 } } )->ArgNames( { "degree", "points", "d", "isa" } );
+BENCHMARK_TEMPLATE( Sampling_Evaluate, float )->ArgsProduct( { { 3, 5 }, { 1024 }, { 1, 0 } } )->ArgNames( { "degree", "points", "threads" } );
+BENCHMARK_TEMPLATE( Sampling_Evaluate, double )->ArgsProduct( { { 3, 5 }, { 1024 }, { 1, 0 } } )->ArgNames( { "degree", "points", "threads" } );
+BENCHMARK_TEMPLATE( Bundle_Curves, float )->ArgsProduct( { { 3 }, { 1024 } } )->ArgNames( { "degree", "curves" } );
+BENCHMARK_TEMPLATE( Bundle_Curves, double )->ArgsProduct( { { 3 }, { 1024 } } )->ArgNames( { "degree", "curves" } );
+BENCHMARK_TEMPLATE( Bundle_Evaluate, float )->ArgsProduct( { { 3 }, { 1024 } } )->ArgNames( { "degree", "curves" } );
+BENCHMARK_TEMPLATE( Bundle_Evaluate, double )->ArgsProduct( { { 3 }, { 1024 } } )->ArgNames( { "degree", "curves" } );
+BENCHMARK_TEMPLATE( Fit_Interpolate, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Fit_Interpolate, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Fit_Approximate, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Fit_Approximate, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Parametric_Length, float )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( Parametric_Length, double )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( Static_Length, float )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( Static_Length, double )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( Static_Length, float, double )->FRAME_ARGS;
+
+BENCHMARK_TEMPLATE( Frenet, float )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( Frenet, double )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( StaticFrenet, float )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( StaticFrenet, double )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( Frame_Table, float )->ArgsProduct( { { 3, 5 }, { 16, 1024 }, { 0, 1 } } )->ArgNames( { "degree", "points", "slerp" } );
+BENCHMARK_TEMPLATE( Frame_Table, double )->ArgsProduct( { { 3, 5 }, { 16, 1024 }, { 0, 1 } } )->ArgNames( { "degree", "points", "slerp" } );
+BENCHMARK_TEMPLATE( Tube, float )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( Tube, double )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( StaticTube, float )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( StaticTube, double )->FRAME_ARGS;
+BENCHMARK_TEMPLATE( Sweep_Tessellate, float )->ArgsProduct( { { 3 }, { 1024 }, { 16, 64 } } )->ArgNames( { "degree", "points", "section" } );
+BENCHMARK_TEMPLATE( Sweep_Tessellate, double )->ArgsProduct( { { 3 }, { 1024 }, { 16, 64 } } )->ArgNames( { "degree", "points", "section" } );
+BENCHMARK_TEMPLATE( Tube_Points, float )->ArgsProduct( { { 3 }, { 1024 }, { 16, 64 } } )->ArgNames( { "degree", "points", "section" } );
+BENCHMARK_TEMPLATE( Tube_Points, double )->ArgsProduct( { { 3 }, { 1024 }, { 16, 64 } } )->ArgNames( { "degree", "points", "section" } );
+BENCHMARK_TEMPLATE( Tube_Rings, float )->ArgsProduct( { { 3 }, { 1024 }, { 16, 64 } } )->ArgNames( { "degree", "points", "section" } );
+BENCHMARK_TEMPLATE( Tube_Rings, double )->ArgsProduct( { { 3 }, { 1024 }, { 16, 64 } } )->ArgNames( { "degree", "points", "section" } );
+
+BENCHMARK_TEMPLATE( Intersection_Pair, float )->ArgsProduct( { { 3 }, { 16, 256 } } )->ArgNames( { "degree", "points" } );
+BENCHMARK_TEMPLATE( Intersection_Pair, double )->ArgsProduct( { { 3 }, { 16, 256 } } )->ArgNames( { "degree", "points" } );
+BENCHMARK_TEMPLATE( Intersection_Batch, float )->ArgsProduct( { { 256, 4096 }, { 1, 0 } } )->ArgNames( { "curves", "threads" } )->UseRealTime();
+BENCHMARK_TEMPLATE( Intersection_Batch, double )->ArgsProduct( { { 256, 4096 }, { 1, 0 } } )->ArgNames( { "curves", "threads" } )->UseRealTime();
+
+BENCHMARK_TEMPLATE( Binary_Write, float )->Arg( 100000 )->ArgName( "curves" );
+BENCHMARK_TEMPLATE( Binary_Write, double )->Arg( 100000 )->ArgName( "curves" );
+BENCHMARK_TEMPLATE( Binary_Read, float )->Arg( 100000 )->ArgName( "curves" );
+BENCHMARK_TEMPLATE( Binary_Read, double )->Arg( 100000 )->ArgName( "curves" );
+
+BENCHMARK_TEMPLATE( Vector_Add, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Vector_Add, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Vector_Dot, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Vector_Dot, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Vector_Cross, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Vector_Cross, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Vector_Normalize, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Vector_Normalize, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Matrix_Product, float );
+BENCHMARK_TEMPLATE( Matrix_Product, double );
+BENCHMARK_TEMPLATE( Matrix_Vector, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Matrix_Vector, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Matrix_Transform, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Matrix_Transform, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Matrix_TransformEach, float )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Matrix_TransformEach, double )->ARRAY_ARGS;
+BENCHMARK_TEMPLATE( Matrix_Inverse, float, 3 )->Arg( 1024 )->ArgName( "n" );
+BENCHMARK_TEMPLATE( Matrix_Inverse, double, 3 )->Arg( 1024 )->ArgName( "n" );
+BENCHMARK_TEMPLATE( Matrix_Inverse, float, 4 )->Arg( 1024 )->ArgName( "n" );
+BENCHMARK_TEMPLATE( Matrix_Inverse, double, 4 )->Arg( 1024 )->ArgName( "n" );
+BENCHMARK_TEMPLATE( Matrix_Eigen, float )->Arg( 1024 )->ArgName( "n" );
+BENCHMARK_TEMPLATE( Matrix_Eigen, double )->Arg( 1024 )->ArgName( "n" );
+BENCHMARK_TEMPLATE( Matrix_Polar, float )->Arg( 1024 )->ArgName( "n" );
+BENCHMARK_TEMPLATE( Matrix_Polar, double )->Arg( 1024 )->ArgName( "n" );
+
+BENCHMARK_MAIN();
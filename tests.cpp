@@ -0,0 +1,1060 @@
+/** -*- C++ -*-
+ * @file tests.cpp
+ * @author Charly LERSTEAU
+ * @date 2026-10-18
+ * 
+ * Copyright (c) 2011 Charly LERSTEAU
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+/*
+ * Unit tests: results checked against known values.
+ *
+ * Each test function reports its failed checks; the program returns the
+ * number of failures (0 = success) for CTest.
+ */
+
+#include "NURBS.hpp"
+#include "View.hpp"
+#include "FixedNURBS.hpp"
+#include "Sampling.hpp"
+#include "Bundle.hpp"
+#include "Fit.hpp"
+#include "Algebra.hpp"
+#include "Transform.hpp"
+#include "Parallel.hpp"
+#include "Quaternion.hpp"
+#include "Frenet.hpp"
+#include "Tube.hpp"
+#include "Sweep.hpp"
+#include "Intersection.hpp"
+#include "Binary.hpp"
+#include <atomic>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <limits>
+#include <type_traits>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+
+static int failures = 0;
+
+#define CHECK( condition ) \
+	do { if ( !( condition ) ) { std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; failures++; } } while ( 0 )
+
+#define CHECK_NEAR( a, b, tolerance ) \
+	CHECK( std::fabs( (double)( a ) - (double)( b ) ) <= ( tolerance ) )
+
+typedef geom::Vector2d Point2;
+typedef geom::Vector3d Point3;
+typedef geom::Vector<2, double> Vector2;
+typedef geom::Vector<3, double> Vector3;
+typedef geom::WeightedPoint<2, double> Weighted2;
+
+/**
+ * @brief Quarter of the unit circle, from (1, 0) to (0, 1).
+ */
+static curve::NURBS<2, double> quarterCircle()
+{
+	std::vector<Weighted2> P;
+
+	P.push_back( Weighted2( Point2( 1, 0 ), 1 ) );
+	P.push_back( Weighted2( Point2( 1, 1 ), std::sqrt( 0.5 ) ) );
+	P.push_back( Weighted2( Point2( 0, 1 ), 1 ) );
+	return curve::NURBS<2, double>( P, std::vector<double>{ 0, 0, 0, 1, 1, 1 }, 2 );
+}
+
+/**
+ * @brief Open cubic through a few points of the plane.
+ */
+static curve::NURBS<2, double> openCubic()
+{
+	std::vector<Vector2> P;
+
+	P.push_back( Point2( 0, 0 ) );
+	P.push_back( Point2( 1, 2 ) );
+	P.push_back( Point2( 3, 2 ) );
+	P.push_back( Point2( 4, 0 ) );
+	P.push_back( Point2( 6, 1 ) );
+	return curve::NURBS<2, double>( P, std::vector<double>{ 0, 0, 0, 0, 0.5, 1, 1, 1, 1 }, 3 );
+}
+
+/**
+ * @brief Line t -> ( t, t ), overridden by Parabola.
+ */
+class Line : public curve::Parametric<2, double>
+{
+public:
+	virtual Point operator()( const double& t ) const { return Point2( t, t ); }
+	virtual Point derivative( const double&, int k = 1 ) const { return k == 1 ? Point2( 1, 1 ) : Point2( 0, 0 ); }
+};
+
+/**
+ * @brief Parabola t -> ( t, t^2 ).
+ */
+class Parabola final : public Line
+{
+public:
+	virtual Point operator()( const double& t ) const { return Point2( t, t * t ); }
+	virtual Point derivative( const double& t, int k = 1 ) const { return k == 1 ? Point2( 1, 2 * t ) : Point2( 0, k == 2 ? 2 : 0 ); }
+};
+
+static void testStaticDispatch()
+{
+	Parabola parabola;
+	const Line & line = parabola;
+
+	static_assert( curve::IsStatic<Parabola>::value, "final curves are evaluated statically" );
+	static_assert( curve::IsStatic<curve::NURBS<3, float> >::value, "NURBS is evaluated statically" );
+	static_assert( !curve::IsStatic<Line>::value, "overridable curves are evaluated virtually" );
+	static_assert( !curve::IsStatic<curve::SplineView<3, float> >::value, "overridable curves are evaluated virtually" );
+
+	// A Parabola behind a Line still evaluates as a parabola
+	CHECK_NEAR( curve::Static<Line>::point( line, 0.5 )[ 1 ], 0.25, 1e-15 );
+	CHECK_NEAR( curve::Static<Line>::derivative( line, 0.5 )[ 1 ], 1, 1e-15 );
+	CHECK_NEAR( curve::Static<Parabola>::point( parabola, 0.5 )[ 1 ], 0.25, 1e-15 );
+
+	// Arc length of the parabola on [0, 1]
+	CHECK_NEAR( curve::length( line, 0., 1., integral::Simpson<double>( 1e-12, 20 ) ),
+		std::sqrt( 5. ) / 2 + std::asinh( 2. ) / 4, 1e-9 );
+}
+
+static void testRationalCircle()
+{
+	curve::NURBS<2, double> c = quarterCircle();
+	int i;
+
+	for ( i = 0; i <= 32; i++ )
+		CHECK_NEAR( c( i / 32. ).length(), 1, 1e-12 );
+	CHECK_NEAR( c( 0 )[ 0 ], 1, 1e-12 );
+	CHECK_NEAR( c( 1 )[ 1 ], 1, 1e-12 );
+	CHECK_NEAR( c( 0.5 )[ 0 ], std::sqrt( 0.5 ), 1e-12 );
+
+	// Tangent orthogonal to the radius
+	for ( i = 0; i <= 8; i++ )
+		CHECK_NEAR( c.derivative( i / 8. ) * c( i / 8. ), 0, 1e-12 );
+}
+
+static void testInterpolate()
+{
+	std::vector<Vector2> Q;
+	std::vector<double> u;
+	std::size_t k;
+
+	Q.push_back( Point2( 0, 0 ) );
+	Q.push_back( Point2( 1, 3 ) );
+	Q.push_back( Point2( 2, -1 ) );
+	Q.push_back( Point2( 4, 1 ) );
+	Q.push_back( Point2( 5, 4 ) );
+	Q.push_back( Point2( 7, 2 ) );
+
+	u = curve::chordLength( Q );
+	curve::NURBS<2, double> c = curve::interpolate( Q, u, 3 );
+	for ( k = 0; k < Q.size(); k++ )
+		CHECK_NEAR( ( c( u[ k ] ) - Q[ k ] ).length(), 0, 1e-10 );
+}
+
+template <int N>
+static void checkInverse( const geom::Matrix<N, N, double> & A )
+{
+	geom::Matrix<N, N, double> inv, I;
+	int i, j;
+
+	CHECK( geom::inverse( A, inv ) );
+	I = A * inv;
+	for ( i = 0; i < N; i++ )
+	{
+		for ( j = 0; j < N; j++ )
+			CHECK_NEAR( I[ i ][ j ], i == j ? 1 : 0, 1e-12 );
+	}
+}
+
+static void testInverse()
+{
+	const double a2[] = { 4, 7, 2, 6 };
+	const double a3[] = { 2, -1, 0, -1, 2, -1, 0, -1, 2 };
+	const double a4[] = { 1, 2, 0, 1, 0, 3, 1, 2, 2, 0, 1, 1, 1, 1, 4, 0 };
+	const double singular[] = { 1, 2, 2, 4 };
+	geom::Matrix<2, 2, double> inv;
+
+	checkInverse( geom::Matrix<2, 2, double>( a2 ) );
+	checkInverse( geom::Matrix<3, 3, double>( a3 ) );
+	checkInverse( geom::Matrix<4, 4, double>( a4 ) );
+	CHECK_NEAR( geom::determinant( geom::Matrix<3, 3, double>( a3 ) ), 4, 1e-12 );
+	CHECK( !geom::inverse( geom::Matrix<2, 2, double>( singular ), inv ) );
+}
+
+static void testQuaternion()
+{
+	Vector3 axis = Point3( 1, 2, 3 );
+	geom::Quaternion<double> q, r;
+	double sign;
+	int i;
+
+	axis.normalize();
+	q = geom::Quaternion<double>::fromAxisAngle( axis, 2.5 );
+	r = geom::Quaternion<double>( q.matrix() );
+
+	// q and -q are the same rotation
+	sign = q.w() * r.w() < 0 ? -1 : 1;
+	for ( i = 0; i < 4; i++ )
+		CHECK_NEAR( r[ i ], sign * q[ i ], 1e-12 );
+
+	// The axis is left unchanged by the rotation
+	CHECK_NEAR( ( q.matrix() * axis - axis ).length(), 0, 1e-12 );
+}
+
+static void testFixedNURBS()
+{
+	static const Weighted2 P[] = {
+		Weighted2( Point2( 0, 0 ), 1 ), Weighted2( Point2( 1, 2 ), 0.5 ), Weighted2( Point2( 3, 2 ), 2 ),
+		Weighted2( Point2( 4, 0 ), 1 ), Weighted2( Point2( 6, 1 ), 1 ) };
+	static const double U[] = { 0, 0, 0, 0, 0.25, 1, 1, 1, 1 };
+	curve::FixedNURBS<2, 8, double> fixed( P, 5, U, 3 );
+	curve::NURBS<2, double> c( std::vector<Weighted2>( P, P + 5 ), std::vector<double>( U, U + 9 ), 3 );
+	int i;
+
+	for ( i = 0; i <= 20; i++ )
+		CHECK_NEAR( ( fixed( i / 20. ) - c( i / 20. ) ).length(), 0, 1e-12 );
+
+	// Rational arc sampled at compile time
+	static constexpr Weighted2 A[] = {
+		Weighted2( Point2( 1, 0 ), 1 ), Weighted2( Point2( 1, 1 ), 2 ), Weighted2( Point2( 0, 1 ), 1 ) };
+	static constexpr curve::FixedNURBS<2, 4, double> arc( A, 3, 2 );
+	static constexpr auto table = arc.sample<5>( 0., 1. );
+	static_assert( table.size() == 5, "sample<Count> returns Count points" );
+	static_assert( table[ 0 ][ 0 ] == 1 && table[ 0 ][ 1 ] == 0 && table[ 4 ][ 0 ] == 0 && table[ 4 ][ 1 ] == 1,
+		"the arc is clamped to its end points" );
+	static_assert( table[ 2 ][ 0 ] - 5. / 6 < 1e-15 && 5. / 6 - table[ 2 ][ 0 ] < 1e-15 && table[ 2 ][ 0 ] == table[ 2 ][ 1 ],
+		"C(1/2) = ( 5/6, 5/6 ) with the weights 1, 2, 1" );
+
+	curve::NURBS<2, double> rational( std::vector<Weighted2>( A, A + 3 ), 2 );
+	for ( i = 0; i < 5; i++ )
+		CHECK_NEAR( ( table[ i ] - rational( i / 4. ) ).length(), 0, 1e-15 );
+}
+
+static void testMoveAndSetters()
+{
+	curve::NURBS<2, double> reference = openCubic();
+	std::vector<Weighted2> P = reference.controlPoints();
+	std::vector<double> U = reference.knotVector();
+	const Weighted2 * points = P.data();
+	const double * knots = U.data();
+	int i;
+
+	// Moved arrays are handed over without a copy
+	curve::NURBS<2, double> c( std::move( P ), std::move( U ), 3 );
+	CHECK( c.controlPoints().data() == points );
+	CHECK( c.knotVector().data() == knots );
+
+	curve::NURBS<2, double> moved( std::move( c ) );
+	CHECK( moved.controlPoints().data() == points );
+	CHECK( moved.knotVector().data() == knots );
+	for ( i = 0; i <= 16; i++ )
+		CHECK( moved( i / 16. ) == reference( i / 16. ) );
+
+	// setControlPoints() recomputes the uniform knot vector
+	curve::NURBS<2, double> uniform( 3 );
+	uniform.setControlPoints( reference.controlPoints() );
+	CHECK( uniform.isUniform() );
+	CHECK( uniform.knotVector().size() == reference.controlPoints().size() + 3 + 1 );
+
+	// setKnotVector() makes the curve non-uniform and keeps the given knots
+	uniform.setKnotVector( reference.knotVector() );
+	CHECK( !uniform.isUniform() );
+	CHECK( uniform.knotVector() == reference.knotVector() );
+	for ( i = 0; i <= 16; i++ )
+		CHECK_NEAR( ( uniform( i / 16. ) - reference( i / 16. ) ).length(), 0, 1e-12 );
+
+	// Later insertions keep the user knots
+	uniform.setKnotVector( std::vector<double>{ 0, 0, 0, 0, 0.25, 0.5, 1, 1, 1, 1 } );
+	uniform.emplaceControlPoint( Point2( 7, 3 ), 1. );
+	CHECK( !uniform.isUniform() );
+	CHECK( uniform.knotVector().size() == 10 );
+	CHECK( uniform.controlPoints().size() == 6 );
+}
+
+static void testSpanGrid()
+{
+	std::vector<Vector2> P;
+	std::vector<double> U( 4, 0 ), u;
+	int n, i, span, hint;
+
+	// 38 spans of growing length, one of them empty (double knot)
+	for ( i = 1; i <= 38; i++ )
+		U.push_back( i == 20 ? U.back() : i * i * i / 1000. );
+	U.insert( U.end(), 3, U.back() );
+	n = U.size() - 3 - 2;
+	for ( i = 0; i <= n; i++ )
+		P.push_back( Point2( i, i % 3 ) );
+	curve::NURBS<2, double> c( P, U, 3 );
+	CHECK( !c.isUniform() );
+
+	// Every knot, the middle of every span and points outside the range
+	for ( i = 0; i < (int)U.size(); i++ )
+	{
+		u.push_back( U[ i ] );
+		if ( i + 1 < (int)U.size() )
+			u.push_back( ( U[ i ] + U[ i+1 ] ) / 2 );
+	}
+	for ( i = -10; i <= 1010; i++ )
+		u.push_back( U.back() * i / 1000. );
+
+	// The grid and the hinted search agree with the binary search
+	hint = 3;
+	for ( i = 0; i < (int)u.size(); i++ )
+	{
+		span = basis::findSpan( n, 3, u[ i ], U );
+		CHECK( c.findSpan( u[ i ] ) == span );
+		CHECK( c.findSpan( u[ i ], hint ) == span );
+		hint = span;
+	}
+}
+
+static void testInstrument()
+{
+	curve::NURBS<2, double> c = openCubic();
+	instrument::Snapshot s;
+	std::ostringstream json;
+	int i;
+
+	s.count[ instrument::FindSpan ] = 12;
+	s.time[ instrument::Sampling ] = 7;
+	instrument::dump( json, s );
+	CHECK( json.str().find( "{\"findSpan\": {\"count\": 12, \"time_ns\": 0}, \"basisFuns\": {\"count\": 0" ) == 0 );
+	CHECK( json.str().find( "\"sampling\": {\"count\": 0, \"time_ns\": 7}}" ) != std::string::npos );
+
+	instrument::reset();
+	for ( i = 0; i < 10; i++ )
+		c( i / 10. );
+
+	// Counts of a finished thread are kept
+	std::thread worker( [ &c ]() { for ( int j = 0; j < 5; j++ ) c( j / 5. ); } );
+	worker.join();
+	s = instrument::snapshot();
+
+#ifdef GEOM_INSTRUMENT
+	CHECK( s.count[ instrument::CurvePoint ] == 15 );
+	CHECK( s.count[ instrument::FindSpan ] == 15 );
+	CHECK( s.count[ instrument::BasisFuns ] == 15 );
+	CHECK( s.count[ instrument::Derivative ] == 0 );
+#ifdef GEOM_INSTRUMENT_TIMERS
+	CHECK( s.time[ instrument::CurvePoint ] > 0 );
+#endif
+	instrument::reset();
+	s = instrument::snapshot();
+#endif
+	for ( i = 0; i < instrument::NumCounters; i++ )
+		CHECK( s.count[ i ] == 0 && s.time[ i ] == 0 );
+}
+
+static void testSimpsonResult()
+{
+	auto cubic = []( double x ) { return x * x * x; };
+	auto root = []( double x ) { return std::sqrt( x ); };
+	integral::Simpson<double> simpson( 1e-14, 4 );
+	integral::Result<double> result;
+
+	CHECK( integral::Simpson<double>().getMaxRecursionDepth() == 6 );
+
+	// Simpson's rule is exact on cubics: one split is enough
+	CHECK_NEAR( simpson( cubic, 0., 1., result ), 0.25, 1e-15 );
+	CHECK( result.converged );
+	CHECK( result.depth == 1 );
+	CHECK( result.evaluations == 5 );
+
+	// sqrt is not smooth at 0: the maximum depth is reached, not exceeded
+	CHECK( simpson( root, 0., 1., result ) == simpson( root, 0., 1. ) );
+	CHECK( !result.converged );
+	CHECK( result.depth == 4 );
+	CHECK( result.evaluations <= 1 + 2 * ( 1 << 4 ) );
+	CHECK_NEAR( result.value, 2. / 3, 1e-3 );
+	CHECK( result.error > 0 );
+}
+
+/**
+ * @brief Non-planar cubic of space.
+ */
+static curve::NURBS<3, double> spaceCubic()
+{
+	std::vector<Vector3> P;
+
+	P.push_back( Point3( 0, 0, 0 ) );
+	P.push_back( Point3( 1, 0, 0 ) );
+	P.push_back( Point3( 1, 1, 0 ) );
+	P.push_back( Point3( 0, 1, 1 ) );
+	return curve::NURBS<3, double>( P, std::vector<double>{ 0, 0, 0, 0, 1, 1, 1, 1 }, 3 );
+}
+
+static void testViews()
+{
+	typedef geom::WeightedPoint<3, double> Weighted3;
+	static const double U[] = { 0, 0, 0, 0, 0.25, 0.5, 0.75, 1, 1, 1, 1 };
+	std::vector<Weighted3> P;
+	std::vector<double> packed, soa, weights, homogeneous;
+	int i, k, d;
+	double t;
+
+	for ( i = 0; i < 7; i++ )
+		P.push_back( Weighted3( Point3( i, i % 2 ? 2 : -1, i * i / 4. ), 0.5 + ( i * 3 ) % 4 ) );
+	curve::NURBS<3, double> c( P, std::vector<double>( U, U + 11 ), 3 );
+	curve::NURBS<3, double> polynomial( std::vector<Vector3>( P.begin(), P.end() ), std::vector<double>( U, U + 11 ), 3 );
+
+	// Array of structures, structure of arrays, homogeneous coordinates
+	soa.resize( 3 * 7 );
+	for ( i = 0; i < 7; i++ )
+	{
+		for ( k = 0; k < 3; k++ )
+		{
+			packed.push_back( P[ i ][ k ] );
+			soa[ k * 7 + i ] = P[ i ][ k ];
+			homogeneous.push_back( P[ i ][ k ] * P[ i ].weight() );
+		}
+		homogeneous.push_back( P[ i ].weight() );
+		weights.push_back( P[ i ].weight() );
+	}
+
+	curve::SplineView<3, double> spline( 7, 3, curve::Strided<double>( U ), curve::Strided<double>( packed.data(), 3 ) );
+	curve::NURBSView<3, double> separate( 7, 3, curve::Strided<double>( U ), curve::Strided<double>( soa.data(), 1, 7 ),
+		curve::Strided<double>( weights.data() ) );
+	curve::NURBSView<3, double> premultiplied( 7, 3, curve::Strided<double>( U ), curve::Strided<double>( homogeneous.data(), 4 ),
+		curve::Strided<double>( homogeneous.data() + 3, 4 ), true );
+	curve::NURBSView<3, double> uniform = separate;
+	uniform.setUniform( true );
+
+	CHECK( !spline.isRational() && separate.isRational() );
+	for ( i = 0; i < 7; i++ )
+	{
+		CHECK( ( premultiplied.controlPoint( i ) - P[ i ] ).length() <= 1e-15 );
+		CHECK( premultiplied.controlPoint( i ).weight() == P[ i ].weight() );
+	}
+
+	for ( i = 0; i <= 40; i++ )
+	{
+		t = i / 40.;
+		CHECK_NEAR( ( spline( t ) - polynomial( t ) ).length(), 0, 1e-12 );
+		CHECK_NEAR( ( separate( t ) - c( t ) ).length(), 0, 1e-12 );
+		CHECK_NEAR( ( premultiplied( t ) - c( t ) ).length(), 0, 1e-12 );
+		CHECK_NEAR( ( uniform( t ) - c( t ) ).length(), 0, 1e-12 );
+		for ( d = 1; d <= 4; d++ )
+		{
+			CHECK_NEAR( ( spline.derivative( t, d ) - polynomial.derivative( t, d ) ).length(), 0, 1e-9 );
+			CHECK_NEAR( ( separate.derivative( t, d ) - c.derivative( t, d ) ).length(), 0, 1e-9 * ( 1 + c.derivative( t, d ).length() ) );
+			CHECK_NEAR( ( premultiplied.derivative( t, d ) - c.derivative( t, d ) ).length(), 0, 1e-9 * ( 1 + c.derivative( t, d ).length() ) );
+		}
+	}
+}
+
+static void testSamplingPlan()
+{
+	curve::NURBS<2, double> c = openCubic();
+	std::vector<Weighted2> P = c.controlPoints();
+	std::vector<double> t;
+	std::vector<Vector2> out, threaded( 101, Point2( 0, 0 ) ), bound( 101, Point2( 0, 0 ) );
+	int i, k;
+
+	for ( i = 0; i <= 100; i++ )
+		t.push_back( i / 100. );
+	curve::SamplingPlan<2, double> plan( c, t, 2 );
+	CHECK( plan.size() == t.size() && plan.pointCount() == P.size() );
+
+	// Non-rational, then rational control points
+	for ( int rational = 0; rational < 2; rational++ )
+	{
+		if ( rational )
+		{
+			for ( i = 0; i < (int)P.size(); i++ )
+				P[ i ].weight() = 0.5 + i % 3;
+			c.setControlPoints( P );
+		}
+		plan.bind( P );
+		for ( k = 0; k <= 2; k++ )
+		{
+			plan.evaluate( c, out, k );
+			plan.evaluate( P, threaded.data(), k, 3 );
+			plan.evaluate( bound.data(), k, 2 );
+			for ( i = 0; i <= 100; i++ )
+			{
+				Vector2 expected = k ? c.derivative( t[ i ], k ) : c( t[ i ] );
+				CHECK_NEAR( ( out[ i ] - expected ).length(), 0, 1e-10 * ( 1 + expected.length() ) );
+				CHECK( threaded[ i ] == out[ i ] );
+				CHECK( bound[ i ] == out[ i ] );
+			}
+		}
+	}
+
+	// Invalid arguments throw, even without assertions
+	std::vector<Weighted2> fewer( P.begin(), P.end() - 1 );
+	bool thrown[ 5 ] = { false, false, false, false, false };
+	try { plan.bind( fewer ); } catch ( const std::invalid_argument & ) { thrown[ 0 ] = true; }
+	try { plan.evaluate( fewer, out.data() ); } catch ( const std::invalid_argument & ) { thrown[ 1 ] = true; }
+	try { plan.evaluate( P, out.data(), 3 ); } catch ( const std::invalid_argument & ) { thrown[ 2 ] = true; }
+	try { plan.evaluate( out.data(), -1 ); } catch ( const std::invalid_argument & ) { thrown[ 3 ] = true; }
+	plan.build( c, t );
+	try { plan.evaluate( out.data() ); } catch ( const std::runtime_error & ) { thrown[ 4 ] = true; }
+	for ( i = 0; i < 5; i++ )
+		CHECK( thrown[ i ] );
+}
+
+/**
+ * @brief Zigzag of count points with integer knots (exact in float).
+ */
+template <class Real, class Compute>
+static curve::NURBS<3, Real, Compute> zigzag( int count )
+{
+	std::vector<geom::Vector<3, Real> > P;
+	std::vector<Real> U;
+	int i;
+
+	for ( i = 0; i < count; i++ )
+		P.push_back( geom::Vector3<Real>( i, i % 2 ? 3 : -3, ( i * 7 ) % 5 ) );
+	U.assign( 4, 0 );
+	for ( i = 1; i < count - 3; i++ )
+		U.push_back( i );
+	U.insert( U.end(), 4, count - 3 );
+	return curve::NURBS<3, Real, Compute>( P, U, 3 );
+}
+
+static void testMixedPrecision()
+{
+	curve::NURBS<3, double> reference = zigzag<double, double>( 1024 );
+	curve::NURBS<3, float, double> mixed = zigzag<float, double>( 1024 );
+	double length;
+	int i;
+
+	// The speed and the sums are computed in Compute
+	static_assert( std::is_same<decltype( curve::Speed<curve::NURBS<3, float, double>, double>( mixed )( 0.f ) ), double>::value,
+		"the speed is computed in Compute" );
+	CHECK( mixed.length() == mixed.length( 0, 1021, integral::Simpson<float, double>() ) );
+
+	// Float storage with double computation matches the double curve
+	length = reference.length();
+	CHECK_NEAR( mixed.length(), length, length * std::numeric_limits<float>::epsilon() );
+	for ( i = 0; i <= 16; i++ )
+		CHECK_NEAR( ( geom::Vector<3, double>( mixed( i * 1021 / 16.f ) ) - reference( i * 1021 / 16. ) ).length(), 0, 1e-3 );
+}
+
+/**
+ * @brief Instruction sets of the host, to run every kernel variant.
+ */
+static std::vector<geom::cpu::Isa> hostIsas()
+{
+	std::vector<geom::cpu::Isa> isas;
+	int i;
+
+	for ( i = 0; i < geom::cpu::NumIsas; i++ )
+		if ( geom::cpu::supports( (geom::cpu::Isa)i ) )
+			isas.push_back( (geom::cpu::Isa)i );
+	return isas;
+}
+
+static void testDispatch()
+{
+	const char * env = std::getenv( "GEOM_ISA" );
+	const geom::cpu::Isa initial = geom::cpu::isa();
+	std::vector<geom::cpu::Isa> isas = hostIsas();
+	std::vector<Weighted2> P;
+	std::vector<double> t;
+	std::vector<Vector2> out;
+	std::size_t i, j;
+	int k;
+
+	// GEOM_ISA selects a supported instruction set (see CMakeLists.txt)
+	if ( env )
+	{
+		for ( k = 0; k < geom::cpu::NumIsas; k++ )
+			if ( std::strcmp( env, geom::cpu::name( (geom::cpu::Isa)k ) ) == 0 && geom::cpu::supports( (geom::cpu::Isa)k ) )
+				CHECK( initial == k );
+	}
+	else
+		CHECK( initial == geom::cpu::best() );
+
+	CHECK( geom::cpu::supports( geom::cpu::Generic ) );
+	CHECK( !geom::cpu::setIsa( geom::cpu::NumIsas ) );
+	for ( k = 0; k < geom::cpu::NumIsas; k++ )
+		if ( !geom::cpu::supports( (geom::cpu::Isa)k ) )
+			CHECK( !geom::cpu::setIsa( (geom::cpu::Isa)k ) && geom::cpu::isa() == initial );
+
+	// Rational curve on non-uniform knots, count not a multiple of the lanes
+	for ( i = 0; i < 9; i++ )
+		P.push_back( Weighted2( Point2( i, ( i * 5 ) % 7 ), 1 + ( i % 3 ) * 0.5 ) );
+	curve::NURBS<2, double> c( P, std::vector<double>{ 0, 0, 0, 0, 0.1, 0.15, 0.4, 0.7, 0.75, 1, 1, 1, 1 }, 3 );
+	for ( i = 0; i < 37; i++ )
+		t.push_back( i / 36. );
+	out.resize( t.size() );
+
+	for ( j = 0; j < isas.size(); j++ )
+	{
+		CHECK( geom::cpu::setIsa( isas[ j ] ) && geom::cpu::isa() == isas[ j ] );
+		for ( k = 0; k <= 4; k++ )
+		{
+			c.evaluate( t.data(), out.data(), t.size(), k );
+			for ( i = 0; i < t.size(); i++ )
+				CHECK_NEAR( ( out[ i ] - ( k ? c.derivative( t[ i ], k ) : c( t[ i ] ) ) ).length(), 0, 1e-9 * ( 1 + c.derivative( t[ i ], k ).length() ) );
+		}
+	}
+	geom::cpu::setIsa( initial );
+}
+
+/**
+ * @brief Compares the lane kernels with basisFuns() and dersBasisFuns().
+ */
+template <int Lanes>
+static void checkBasisLanes( const std::vector<double> & U, int p, const std::vector<double> & t )
+{
+	double N_[ ( p+1 ) * Lanes ], ders[ ( p+1 ) * ( p+1 ) * Lanes ], reference[ ( p+1 ) * ( p+1 ) ], u[ Lanes ];
+	int span[ Lanes ], n, j, k, l;
+	std::size_t first;
+
+	n = U.size() - p - 2;
+	for ( first = 0; first < t.size(); first += Lanes )
+	{
+		// Lanes in different spans
+		for ( l = 0; l < Lanes; l++ )
+		{
+			u[ l ] = t[ ( first + l ) % t.size() ];
+			span[ l ] = basis::findSpan( n, p, u[ l ], U );
+		}
+		basis::basisFunsLanes<Lanes>( span, u, p, U, N_ );
+		basis::dersBasisFunsLanes<Lanes>( span, u, p, p, U, ders );
+
+		for ( l = 0; l < Lanes; l++ )
+		{
+			basis::basisFuns( span[ l ], u[ l ], p, U, reference );
+			for ( j = 0; j <= p; j++ )
+				CHECK_NEAR( N_[ j*Lanes + l ], reference[ j ], 1e-14 );
+
+			basis::dersBasisFuns( span[ l ], u[ l ], p, p, U, reference );
+			for ( k = 0; k <= p; k++ )
+				for ( j = 0; j <= p; j++ )
+					CHECK_NEAR( ders[ ( k*(p+1) + j )*Lanes + l ], reference[ k*(p+1) + j ], 1e-10 * ( 1 + std::fabs( reference[ k*(p+1) + j ] ) ) );
+		}
+	}
+}
+
+static void testBasisLanes()
+{
+	std::vector<double> U, t;
+	int p, i;
+
+	for ( i = 0; i <= 50; i++ )
+		t.push_back( i / 50. );
+
+	// Non-uniform knots with a double knot, degrees 1 to 5
+	for ( p = 1; p <= 5; p++ )
+	{
+		U.assign( p+1, 0 );
+		for ( double knot : { 0.05, 0.2, 0.2, 0.45, 0.5, 0.9 } )
+			U.push_back( knot );
+		U.insert( U.end(), p+1, 1 );
+		checkBasisLanes<4>( U, p, t );
+		checkBasisLanes<8>( U, p, t );
+		checkBasisLanes<16>( U, p, t );
+	}
+}
+
+static void testTransform()
+{
+	const double a[] = { 0.5, -1, 2, 3, 1, 0.25 };
+	const double h[] = { 0, -1, 0, 4, 1, 0, 0, -2, 0, 0, 2, 0.5, 0, 0, 0, 1 };
+	const geom::cpu::Isa initial = geom::cpu::isa();
+	std::vector<geom::cpu::Isa> isas = hostIsas();
+	const std::size_t count = 2 * geom::Batch<3, 3, double>::Block + 37;
+	const geom::Matrix<2, 3, double> m( a );
+	const geom::Matrix<4, 4, double> affine( h );
+	std::vector<geom::Matrix<3, 3, double> > frames;
+	std::vector<Vector3> in, out( count, Point3( 0, 0, 0 ) ), inPlace;
+	std::vector<Vector2> projected( count, Point2( 0, 0 ) );
+	std::size_t i, j;
+	unsigned threads;
+
+	// Several blocks, the last one partial
+	for ( i = 0; i < count; i++ )
+	{
+		in.push_back( Point3( i % 17, ( i * 7 ) % 11 - 5., i / 1000. ) );
+		frames.push_back( geom::Quaternion<double>::fromAxisAngle( Point3( 0, 0, 1 ), i * 0.01 ).matrix() );
+	}
+
+	for ( j = 0; j < isas.size(); j++ )
+	{
+		geom::cpu::setIsa( isas[ j ] );
+		for ( threads = 1; threads <= 4; threads += 3 )
+		{
+			geom::transform( m, in.data(), projected.data(), count, threads );
+			for ( i = 0; i < count; i++ )
+				CHECK_NEAR( ( projected[ i ] - m * in[ i ] ).length(), 0, 1e-12 );
+
+			geom::transform( frames.data(), in.data(), out.data(), count, threads );
+			for ( i = 0; i < count; i++ )
+				CHECK_NEAR( ( out[ i ] - frames[ i ] * in[ i ] ).length(), 0, 1e-12 );
+
+			// In place
+			inPlace = in;
+			geom::transformPoints( affine, inPlace.data(), inPlace.data(), count, threads );
+			for ( i = 0; i < count; i++ )
+				CHECK_NEAR( ( inPlace[ i ] - Point3( 4 - in[ i ][ 1 ], in[ i ][ 0 ] - 2, 2 * in[ i ][ 2 ] + 0.5 ) ).length(), 0, 1e-12 );
+		}
+	}
+	geom::cpu::setIsa( initial );
+}
+
+static void testParallelFor()
+{
+	const std::size_t count = 10000;
+	std::vector<std::atomic<int> > calls( count );
+	std::vector<unsigned> workers( count );
+	std::atomic<std::size_t> done( 0 );
+	std::size_t thrower, i;
+	unsigned threads;
+
+	// Every item once, worker indices in range
+	for ( i = 0; i < count; i++ )
+		calls[ i ] = 0;
+	geom::parallelFor( count, 4, [ & ]( std::size_t j, unsigned worker )
+	{
+		calls[ j ]++;
+		workers[ j ] = worker;
+	} );
+	for ( i = 0; i < count; i++ )
+		CHECK( calls[ i ] == 1 && workers[ i ] < geom::threadCount( 4, count ) );
+
+	// The exception of any item, the first one included, reaches the caller
+	for ( threads = 1; threads <= 4; threads += 3 )
+	{
+		for ( thrower = 0; thrower < count; thrower += count / 2 )
+		{
+			std::string message;
+			done = 0;
+			try
+			{
+				geom::parallelFor( count, threads, [ & ]( std::size_t j, unsigned )
+				{
+					if ( j == thrower )
+						throw std::out_of_range( "item " + std::to_string( j ) );
+					done++;
+				} );
+			}
+			catch ( const std::out_of_range & e )
+			{
+				message = e.what();
+			}
+			CHECK( message == "item " + std::to_string( thrower ) );
+			CHECK( threads == 1 ? done == thrower : done < count );
+		}
+	}
+}
+
+static void testBundle()
+{
+	typedef geom::WeightedPoint<3, double> Weighted3;
+	const geom::cpu::Isa initial = geom::cpu::isa();
+	std::vector<geom::cpu::Isa> isas = hostIsas();
+	const std::vector<double> U{ 0, 0, 0, 0, 0.1, 0.3, 0.35, 0.8, 1, 1, 1, 1 };
+	std::vector<curve::NURBS<3, double> > curves;
+	std::vector<Vector3> out;
+	std::size_t i, j, s;
+	int rational;
+
+	// 11 curves: one full block of 8 lanes and a partial one
+	for ( rational = 0; rational < 2; rational++ )
+	{
+		curves.clear();
+		for ( i = 0; i < 11; i++ )
+		{
+			std::vector<Weighted3> P;
+			for ( j = 0; j < 8; j++ )
+				P.push_back( Weighted3( Point3( j, ( i * j ) % 5, (double)i ), rational && ( i + j ) % 3 ? 0.5 + ( i % 4 ) : 1 ) );
+			curves.push_back( curve::NURBS<3, double>( P, U, 3 ) );
+		}
+
+		curve::Bundle<3, double> bundle( curves[ 0 ] );
+		for ( i = 0; i < curves.size(); i++ )
+			bundle.push( curves[ i ] );
+		CHECK( bundle.size() == 11 );
+		CHECK( bundle.isRational() == ( rational == 1 ) );
+
+		for ( j = 0; j < isas.size(); j++ )
+		{
+			geom::cpu::setIsa( isas[ j ] );
+			for ( s = 0; s <= 40; s++ )
+			{
+				bundle( s / 40., out );
+				CHECK( out.size() == 11 );
+				for ( i = 0; i < curves.size(); i++ )
+					CHECK_NEAR( ( out[ i ] - curves[ i ]( s / 40. ) ).length(), 0, 1e-12 );
+			}
+		}
+		geom::cpu::setIsa( initial );
+	}
+
+	// Curves of another shape are rejected, even without assertions
+	curve::Bundle<3, double> bundle( curves[ 0 ] );
+	bool thrown[ 3 ] = { false, false, false };
+	std::vector<Weighted3> fewer( curves[ 0 ].controlPoints().begin(), curves[ 0 ].controlPoints().end() - 1 );
+	curve::NURBS<3, double> quadratic( curves[ 0 ].controlPoints(), std::vector<double>( U.begin() + 1, U.end() ), 2 );
+	curve::NURBS<3, double> moved = curves[ 0 ];
+	moved.setKnotVector( std::vector<double>{ 0, 0, 0, 0, 0.2, 0.3, 0.35, 0.8, 1, 1, 1, 1 } );
+	try { bundle.push( fewer ); } catch ( const std::invalid_argument & ) { thrown[ 0 ] = true; }
+	try { bundle.push( quadratic ); } catch ( const std::invalid_argument & ) { thrown[ 1 ] = true; }
+	try { bundle.push( moved ); } catch ( const std::invalid_argument & ) { thrown[ 2 ] = true; }
+	CHECK( thrown[ 0 ] && thrown[ 1 ] && thrown[ 2 ] );
+	CHECK( bundle.size() == 0 );
+}
+
+static void testSweep()
+{
+	const double s0 = 1, s1 = 2;
+	std::vector<geom::Vector<1, double> > S;
+	std::vector<Vector3> points;
+	curve::NURBS<3, double> c = spaceCubic();
+	curve::NURBS<2, double> profile = quarterCircle();
+	bool thrown;
+	int i, j;
+
+	// Scale growing linearly from 1 to 2
+	S.push_back( geom::Vector<1, double>( &s0 ) );
+	S.push_back( geom::Vector<1, double>( &s1 ) );
+	curve::NURBS<1, double> scale( S, std::vector<double>{ 0, 0, 1, 1 }, 1 );
+
+	// The profile lies on the unit circle: points at r * s(t) from the axis
+	surface::Sweep<double> sweep( c, frame::Frenet<double>(), profile, scale, 0.5 );
+	sweep.tessellate( 0, 1, 5, 0, 1, 4, points );
+	CHECK( points.size() == 5 * 4 );
+	for ( i = 0; i < 5 && points.size() == 5 * 4; i++ )
+	{
+		for ( j = 0; j < 4; j++ )
+		{
+			CHECK_NEAR( ( points[ i*4 + j ] - c( i / 4. ) ).length(), 0.5 * ( 1 + i / 4. ), 1e-12 );
+			CHECK_NEAR( ( points[ i*4 + j ] - sweep( i / 4., j / 3. ) ).length(), 0, 1e-12 );
+		}
+	}
+
+	// Constant radius, given as a double to a float sweep
+	std::vector<geom::Vector<3, float> > A;
+	std::vector<geom::Vector<2, float> > Q;
+	A.push_back( geom::Vector3f( 0, 0, 0 ) );
+	A.push_back( geom::Vector3f( 1, 0, 0 ) );
+	A.push_back( geom::Vector3f( 1, 1, 1 ) );
+	Q.push_back( geom::Vector2f( 1, 0 ) );
+	Q.push_back( geom::Vector2f( 0, 1 ) );
+	curve::NURBS<3, float> axis( A, std::vector<float>{ 0, 0, 0, 1, 1, 1 }, 2 );
+	curve::NURBS<2, float> segment( Q, std::vector<float>{ 0, 0, 1, 1 }, 1 );
+	surface::Sweep<float> constant( axis, frame::Frenet<float>(), segment, 0.5 );
+	CHECK( constant.getRadius() == 0.5f && !constant.getScale() );
+
+	thrown = false;
+	try { sweep.tessellate( 0, 1, 1, 0, 1, 4, points ); }
+	catch ( const std::invalid_argument & ) { thrown = true; }
+	CHECK( thrown );
+
+	thrown = false;
+	try { sweep.tessellate( 0, 1, 5, 0, 1, 1, points ); }
+	catch ( const std::invalid_argument & ) { thrown = true; }
+	CHECK( thrown );
+}
+
+static void testTessellate()
+{
+	std::vector<Vector3> points;
+	surface::Ring<double> ring( 8 );
+	Vector3 last[ 8 ];
+	bool thrown;
+	int i;
+
+	curve::NURBS<3, double> c = spaceCubic();
+	surface::Tube<double> tube( c, frame::Frenet<double>(), 0.5 );
+
+	tube.tessellate( 0, 1, 10, ring, points );
+	CHECK( points.size() == 10 * 8 );
+
+	// Last ring at t1, radius from the curve
+	tube.ring( 1, ring, last );
+	for ( i = 0; i < 8; i++ )
+	{
+		CHECK_NEAR( ( points[ 9*8 + i ] - last[ i ] ).length(), 0, 1e-12 );
+		CHECK_NEAR( ( points[ 9*8 + i ] - c( 1 ) ).length(), 0.5, 1e-12 );
+	}
+
+	thrown = false;
+	try
+	{
+		surface::RingGenerator<surface::Tube<double> > rings( tube, ring, 0, 1, 1 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		thrown = true;
+	}
+	CHECK( thrown );
+}
+
+static void testTubeConstructors()
+{
+	std::vector<geom::Vector<3, float> > P;
+
+	P.push_back( geom::Vector3f( 0, 0, 0 ) );
+	P.push_back( geom::Vector3f( 1, 0, 0 ) );
+	P.push_back( geom::Vector3f( 1, 1, 0 ) );
+	P.push_back( geom::Vector3f( 0, 1, 1 ) );
+	curve::NURBS<3, float> c( P, std::vector<float>{ 0, 0, 0, 0, 1, 1, 1, 1 }, 3 );
+	std::shared_ptr<frame::Frenet<float> > frenet = std::make_shared<frame::Frenet<float> >( c );
+
+	// A double radius is not a frame type: the shared frame is used as is
+	surface::Tube<float> shared( frenet, 0.5 );
+	surface::Tube<float> copied( c, frame::Frenet<float>(), 0.5 );
+
+	CHECK( shared.getFrame() == frenet );
+	CHECK( shared.getRadius() == 0.5f );
+	CHECK( copied.getRadius() == 0.5f );
+	CHECK_NEAR( ( shared( 0.3f, 1.f ) - copied( 0.3f, 1.f ) ).length(), 0, 1e-6 );
+}
+
+static void testRationalIntersection()
+{
+	std::vector<Vector2> P;
+	std::vector<intersection::Hit<2, double> > hits;
+	intersection::CurveCurve<2, double> intersect( 1e-9 );
+
+	P.push_back( Point2( 0, 0 ) );
+	P.push_back( Point2( 1, 1 ) );
+	curve::NURBS<2, double> circle = quarterCircle();
+	curve::NURBS<2, double> diagonal( P, std::vector<double>{ 0, 0, 1, 1 }, 1 );
+
+	intersect( circle, diagonal, hits );
+	CHECK( hits.size() == 1 );
+	if ( hits.size() == 1 )
+	{
+		CHECK_NEAR( hits[ 0 ].s, 0.5, 1e-9 );
+		CHECK_NEAR( hits[ 0 ].t, std::sqrt( 0.5 ), 1e-9 );
+		CHECK_NEAR( hits[ 0 ].point[ 0 ], std::sqrt( 0.5 ), 1e-9 );
+		CHECK_NEAR( hits[ 0 ].point[ 1 ], std::sqrt( 0.5 ), 1e-9 );
+	}
+}
+
+/**
+ * @brief Checks that a file holds the circle and the cubic, in this order.
+ */
+static void checkCurveFile( const std::string & path )
+{
+	io::Reader<2, double> reader( path );
+	curve::NURBS<2, double> expected[] = { quarterCircle(), openCubic() };
+	std::size_t k;
+	int i;
+
+	CHECK( reader.size() == 2 );
+	for ( k = 0; k < 2 && k < reader.size(); k++ )
+	{
+		curve::NURBS<2, double> c = reader.load( k );
+		CHECK( c.getDegree() == expected[ k ].getDegree() );
+		CHECK( c.knotVector() == expected[ k ].knotVector() );
+		CHECK( c.controlPoints().size() == expected[ k ].controlPoints().size() );
+		for ( i = 0; i <= 16; i++ )
+			CHECK_NEAR( ( c( i / 16. ) - expected[ k ]( i / 16. ) ).length(), 0, 1e-12 );
+	}
+}
+
+static void testBinary()
+{
+	const std::string path = "geom_tests.bin";
+	{
+		io::Writer<2, double> writer( path );
+		writer.write( quarterCircle() );
+		writer.write( openCubic() );
+		writer.close();
+	}
+	checkCurveFile( path );
+	std::remove( path.c_str() );
+}
+
+static void testBinaryPipe()
+{
+	const std::string fifo = "geom_tests.fifo", path = "geom_tests_pipe.bin";
+	bool closed;
+
+	// The writer cannot seek back to patch the count into a pipe
+	std::remove( fifo.c_str() );
+	CHECK( mkfifo( fifo.c_str(), 0600 ) == 0 );
+
+	std::thread drain( [ & ]()
+	{
+		std::ifstream in( fifo.c_str(), std::ios::binary );
+		std::ofstream out( path.c_str(), std::ios::binary );
+		out << in.rdbuf();
+	} );
+
+	closed = true;
+	try
+	{
+		io::Writer<2, double> writer( fifo );
+		writer.write( quarterCircle() );
+		writer.write( openCubic() );
+		writer.close();
+	}
+	catch ( const std::runtime_error & )
+	{
+		closed = false;
+	}
+	drain.join();
+
+	CHECK( closed );
+	checkCurveFile( path );
+	std::remove( fifo.c_str() );
+	std::remove( path.c_str() );
+}
+
+int main()
+{
+	testRationalCircle();
+	testStaticDispatch();
+	testInterpolate();
+	testInverse();
+	testQuaternion();
+	testFixedNURBS();
+	testViews();
+	testMoveAndSetters();
+	testSpanGrid();
+	testInstrument();
+	testSimpsonResult();
+	testSamplingPlan();
+	testMixedPrecision();
+	testBasisLanes();
+	testDispatch();
+	testParallelFor();
+	testBundle();
+	testTransform();
+	testSweep();
+	testTessellate();
+	testTubeConstructors();
+	testRationalIntersection();
+	testBinary();
+	testBinaryPipe();
+
+	if ( failures )
+		std::cerr << failures << " check(s) failed" << std::endl;
+	return failures ? 1 : 0;
+}